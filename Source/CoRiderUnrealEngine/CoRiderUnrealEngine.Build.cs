@@ -20,8 +20,12 @@ public class CoRiderUnrealEngine : ModuleRules
 		{
 			"AssetRegistry",
 			"BlueprintGraph",
+			"DirectoryWatcher",
+			"Slate",
+			"SlateCore",
 			"UMG",
 			"UMGEditor",
+			"UnrealEd",
 		});
 	}
 }
@@ -12,6 +12,8 @@
 #include "HttpServerResponse.h"
 #include "Misc/DateTime.h"
 #include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 
@@ -50,7 +52,74 @@ static FString GetDependencyCategoryString(UE::AssetRegistry::EDependencyCategor
 	}
 }
 
-FAssetRefHttpServer::FAssetRefHttpServer()
+/**
+ * Quality an Accept header gives ContentType, taken from its most specific matching media range: the exact
+ * type, then the type's wildcard, then the catch-all. 0 when nothing matches or the match has q=0.
+ */
+static float GetAcceptQuality(const FString& Accept, const FString& ContentType)
+{
+	FString Type;
+	FString Subtype;
+	ContentType.Split(TEXT("/"), &Type, &Subtype);
+
+	int32 BestSpecificity = 0;
+	float BestQuality = 0.0f;
+	TArray<FString> Ranges;
+	Accept.ParseIntoArray(Ranges, TEXT(","));
+	for (const FString& Range : Ranges)
+	{
+		TArray<FString> Parts;
+		Range.ParseIntoArray(Parts, TEXT(";"));
+		if (Parts.IsEmpty())
+		{
+			continue;
+		}
+
+		const FString MediaRange = Parts[0].TrimStartAndEnd();
+		const int32 Specificity = MediaRange.Equals(ContentType, ESearchCase::IgnoreCase) ? 3
+			: MediaRange.Equals(Type + TEXT("/*"), ESearchCase::IgnoreCase) ? 2
+			: MediaRange == TEXT("*/*") ? 1 : 0;
+		if (Specificity <= BestSpecificity)
+		{
+			continue;
+		}
+
+		float Quality = 1.0f;
+		for (int32 Index = 1; Index < Parts.Num(); ++Index)
+		{
+			const FString Param = Parts[Index].TrimStartAndEnd();
+			if (Param.StartsWith(TEXT("q="), ESearchCase::IgnoreCase))
+			{
+				Quality = FCString::Atof(*Param.RightChop(2));
+			}
+		}
+		BestSpecificity = Specificity;
+		BestQuality = Quality;
+	}
+	return BestQuality;
+}
+
+static void SendAuditError(const FHttpResultCallback& OnComplete, EHttpServerResponseCodes Code, const FString& Error, const FString& PackageName)
+{
+	TSharedRef<FJsonObject> ErrorJson = MakeShared<FJsonObject>();
+	ErrorJson->SetStringField(TEXT("error"), Error);
+	if (!PackageName.IsEmpty())
+	{
+		ErrorJson->SetStringField(TEXT("package"), PackageName);
+	}
+	ErrorJson->SetStringField(TEXT("usage"), TEXT("/audit/blueprint?package=/Game/Path/To/BP (Accept: application/json or application/x-ue-cb)"));
+
+	FString Body;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Body);
+	FJsonSerializer::Serialize(ErrorJson, Writer);
+
+	auto Response = FHttpServerResponse::Create(Body, TEXT("application/json"));
+	Response->Code = Code;
+	OnComplete(MoveTemp(Response));
+}
+
+FAssetRefHttpServer::FAssetRefHttpServer(const FString& InMarkerFileName)
+	: MarkerFileName(InMarkerFileName)
 {
 }
 
@@ -59,6 +128,11 @@ FAssetRefHttpServer::~FAssetRefHttpServer()
 	Stop();
 }
 
+void FAssetRefHttpServer::AddRoute(const FHttpPath& Path, EHttpServerRequestVerbs Verbs, const FHttpRequestHandler& Handler)
+{
+	ExtraRoutes.Add({ Path, Verbs, Handler });
+}
+
 bool FAssetRefHttpServer::Start()
 {
 	for (int32 Port = PortRangeStart; Port <= PortRangeEnd; ++Port)
@@ -126,6 +200,17 @@ bool FAssetRefHttpServer::TryBind(int32 Port)
 		EHttpServerRequestVerbs::VERB_GET,
 		FHttpRequestHandler::CreateRaw(this, &FAssetRefHttpServer::HandleReferencers)));
 
+	// GET /audit/blueprint
+	Handles.Add(Router->BindRoute(
+		FHttpPath(TEXT("/audit/blueprint")),
+		EHttpServerRequestVerbs::VERB_GET,
+		FHttpRequestHandler::CreateRaw(this, &FAssetRefHttpServer::HandleBlueprintAudit)));
+
+	for (const FExtraRoute& Route : ExtraRoutes)
+	{
+		Handles.Add(Router->BindRoute(Route.Path, Route.Verbs, Route.Handler));
+	}
+
 	// Check all handles are valid
 	for (const FHttpRouteHandle& Handle : Handles)
 	{
@@ -168,9 +253,9 @@ void FAssetRefHttpServer::DeleteMarkerFile() const
 	IFileManager::Get().Delete(*MarkerPath, false, false, true);
 }
 
-FString FAssetRefHttpServer::GetMarkerFilePath()
+FString FAssetRefHttpServer::GetMarkerFilePath() const
 {
-	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT(".corider-ue-server.json"));
+	return FPaths::Combine(FPaths::ProjectSavedDir(), MarkerFileName);
 }
 
 // -- Route handlers --
@@ -293,3 +378,64 @@ bool FAssetRefHttpServer::HandleAssetQuery(const FHttpServerRequest& Request, co
 	return true;
 }
 
+bool FAssetRefHttpServer::HandleBlueprintAudit(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	FString PackageName;
+	if (const FString* Param = Request.QueryParams.Find(TEXT("package")))
+	{
+		PackageName = FPackageName::ObjectPathToPackageName(*Param);
+	}
+	// The name becomes a file path below, so anything that could climb out of the audit tree is refused
+	if (!PackageName.StartsWith(TEXT("/Game/")) || PackageName.Contains(TEXT(".."))
+		|| !FPackageName::IsValidLongPackageName(PackageName))
+	{
+		SendAuditError(OnComplete, EHttpServerResponseCodes::BadRequest, TEXT("Missing, invalid or non-/Game/ 'package' query parameter"), PackageName);
+		return true;
+	}
+
+	// No Accept header keeps the JSON every existing client expects; a tie goes to JSON too
+	float JsonQuality = 1.0f;
+	float CompactBinaryQuality = 0.0f;
+	if (const TArray<FString>* AcceptValues = Request.Headers.Find(TEXT("Accept")))
+	{
+		const FString Accept = FString::Join(*AcceptValues, TEXT(","));
+		JsonQuality = GetAcceptQuality(Accept, TEXT("application/json"));
+		CompactBinaryQuality = GetAcceptQuality(Accept, FBlueprintAuditor::CompactBinaryContentType);
+	}
+
+	const FString JsonPath = FBlueprintAuditor::GetAuditOutputPath(PackageName);
+	const FString CompactBinaryPath = FBlueprintAuditor::GetCompactBinaryPath(JsonPath);
+
+	FString FullJsonPath = FPaths::ConvertRelativePathToFull(JsonPath);
+	FPaths::CollapseRelativeDirectories(FullJsonPath);
+	if (!FPaths::IsUnderDirectory(FullJsonPath, FPaths::ConvertRelativePathToFull(FBlueprintAuditor::GetAuditBaseDir())))
+	{
+		SendAuditError(OnComplete, EHttpServerResponseCodes::BadRequest, TEXT("Package does not map into the audit directory"), PackageName);
+		return true;
+	}
+
+	// Compact Binary is only served from disk; when it hasn't been written, fall back to JSON if the client takes it
+	const bool bHaveCompactBinary = CompactBinaryQuality > 0.0f && IFileManager::Get().FileExists(*CompactBinaryPath);
+	const bool bServeCompactBinary = bHaveCompactBinary && (CompactBinaryQuality > JsonQuality || JsonQuality <= 0.0f);
+	if (!bServeCompactBinary && JsonQuality <= 0.0f)
+	{
+		SendAuditError(OnComplete, EHttpServerResponseCodes::NoneAcceptable, CompactBinaryQuality > 0.0f
+			? TEXT("No Compact Binary audit on disk (enable CoRider.Audit.CompactBinary) and JSON is not acceptable")
+			: TEXT("Audits are served as application/json or application/x-ue-cb"), PackageName);
+		return true;
+	}
+
+	TArray<uint8> Body;
+	if (!FFileHelper::LoadFileToArray(Body, bServeCompactBinary ? *CompactBinaryPath : *JsonPath, FILEREAD_Silent))
+	{
+		SendAuditError(OnComplete, EHttpServerResponseCodes::NotFound, TEXT("No audit on disk for this package (POST /audit/requests to queue one)"), PackageName);
+		return true;
+	}
+
+	auto Response = FHttpServerResponse::Create(MoveTemp(Body),
+		bServeCompactBinary ? FBlueprintAuditor::CompactBinaryContentType : TEXT("application/json"));
+	Response->Headers.Add(TEXT("Vary"), { TEXT("Accept") });
+	Response->Headers.Add(TEXT("X-CoRider-Audit-Schema"), { FString::FromInt(FBlueprintAuditor::AuditSchemaVersion) });
+	OnComplete(MoveTemp(Response));
+	return true;
+}
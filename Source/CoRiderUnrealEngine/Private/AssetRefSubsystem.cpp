@@ -1,13 +1,48 @@
 #include "AssetRefSubsystem.h"
 
 #include "AssetRefHttpServer.h"
+#include "BlueprintAuditBatch.h"
 #include "BlueprintAuditor.h"
+#include "BlueprintAuditSubsystem.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "HttpResultCallback.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+static void SendJson(const FHttpResultCallback& OnComplete, const TSharedRef<FJsonObject>& Json,
+	EHttpServerResponseCodes Code = EHttpServerResponseCodes::Ok)
+{
+	FString Body;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Body);
+	FJsonSerializer::Serialize(Json, Writer);
+
+	auto Response = FHttpServerResponse::Create(Body, TEXT("application/json"));
+	Response->Code = Code;
+	OnComplete(MoveTemp(Response));
+}
+
+static TArray<TSharedPtr<FJsonValue>> ToJsonArray(const TArray<FString>& Strings)
+{
+	TArray<TSharedPtr<FJsonValue>> Values;
+	for (const FString& String : Strings)
+	{
+		Values.Add(MakeShared<FJsonValueString>(String));
+	}
+	return Values;
+}
 
 void UAssetRefSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
+	AuditSubsystem = Collection.InitializeDependency<UBlueprintAuditSubsystem>();
+
 	HttpServer = MakeUnique<FAssetRefHttpServer>();
+	RegisterAuditRoutes();
 	if (!HttpServer->Start())
 	{
 		UE_LOG(LogCoRider, Warning, TEXT("CoRider: Asset ref HTTP server failed to start"));
@@ -25,3 +60,58 @@ void UAssetRefSubsystem::Deinitialize()
 
 	Super::Deinitialize();
 }
+
+void UAssetRefSubsystem::RegisterAuditRoutes()
+{
+	// POST /audit/requests
+	HttpServer->AddRoute(FHttpPath(TEXT("/audit/requests")), EHttpServerRequestVerbs::VERB_POST,
+		FHttpRequestHandler::CreateLambda([this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+			const FString Body(Converted.Length(), Converted.Get());
+
+			TSharedPtr<FJsonObject> RequestJson;
+			const TArray<TSharedPtr<FJsonValue>>* Packages = nullptr;
+			if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Body), RequestJson) || !RequestJson.IsValid()
+				|| !RequestJson->TryGetArrayField(TEXT("packages"), Packages))
+			{
+				TSharedRef<FJsonObject> ErrorJson = MakeShared<FJsonObject>();
+				ErrorJson->SetStringField(TEXT("error"), TEXT("Expected {\"packages\": [\"/Game/Path/To/BP\", ...]}"));
+				SendJson(OnComplete, ErrorJson, EHttpServerResponseCodes::BadRequest);
+				return true;
+			}
+
+			UBlueprintAuditSubsystem* Audits = AuditSubsystem.Get();
+			if (!Audits)
+			{
+				TSharedRef<FJsonObject> ErrorJson = MakeShared<FJsonObject>();
+				ErrorJson->SetStringField(TEXT("error"), TEXT("Blueprint audit subsystem is not running"));
+				SendJson(OnComplete, ErrorJson, EHttpServerResponseCodes::ServerError);
+				return true;
+			}
+
+			TArray<FString> Entries;
+			for (const TSharedPtr<FJsonValue>& Value : *Packages)
+			{
+				Entries.Add(Value->AsString());
+			}
+
+			TArray<FBlueprintAuditWorkItem> Items;
+			TArray<FString> MissingPackages;
+			FBlueprintAuditBatch::ResolveAssetList(Entries, Items, MissingPackages);
+
+			TArray<FString> Queued;
+			TArray<FString> UpToDate;
+			for (const FBlueprintAuditWorkItem& Item : Items)
+			{
+				(Audits->RequestAudit(Item) ? Queued : UpToDate).Add(Item.PackageName);
+			}
+
+			TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+			ResponseJson->SetArrayField(TEXT("queued"), ToJsonArray(Queued));
+			ResponseJson->SetArrayField(TEXT("upToDate"), ToJsonArray(UpToDate));
+			ResponseJson->SetArrayField(TEXT("missing"), ToJsonArray(MissingPackages));
+			SendJson(OnComplete, ResponseJson);
+			return true;
+		}));
+}
@@ -0,0 +1,389 @@
+#include "BlueprintAuditBatch.h"
+
+#include "BlueprintAuditor.h"
+#include "BlueprintAuditBundle.h"
+#include "BlueprintAuditCheckpoint.h"
+#include "BlueprintAuditGCPolicy.h"
+#include "BlueprintAuditHashCache.h"
+#include "BlueprintAuditPipeline.h"
+#include "BlueprintAuditPrefetcher.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Blueprint.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+#include <cstdio>
+
+/** Turn one asset-list entry into a long package name. */
+static bool AssetListEntryToPackageName(const FString& Entry, FString& OutPackageName)
+{
+	// File paths: anything with a package extension, a backslash, or not rooted like a package name
+	if (Entry.EndsWith(FPackageName::GetAssetPackageExtension()) || Entry.Contains(TEXT("\\")) || !Entry.StartsWith(TEXT("/")))
+	{
+		FString FilePath = Entry;
+		if (FPaths::IsRelative(FilePath))
+		{
+			FilePath = FPaths::ProjectDir() / FilePath;
+		}
+		FilePath = FPaths::ConvertRelativePathToFull(FilePath);
+		return FPackageName::TryConvertFilenameToLongPackageName(FilePath, OutPackageName);
+	}
+
+	// Package name or object path (/Game/UI/WBP_Foo.WBP_Foo)
+	OutPackageName = FPackageName::ObjectPathToPackageName(Entry);
+	return true;
+}
+
+FBlueprintAuditBatchOptions FBlueprintAuditBatchOptions::FromParams(const FString& Params)
+{
+	FBlueprintAuditBatchOptions Options;
+	FParse::Value(*Params, TEXT("-Threads="), Options.NumThreads);
+	Options.QueueDepth = FMath::Max(Options.NumThreads, 1) * 4;
+	FParse::Value(*Params, TEXT("-QueueDepth="), Options.QueueDepth);
+	FParse::Value(*Params, TEXT("-Prefetch="), Options.PrefetchDepth);
+	FParse::Value(*Params, TEXT("-PrefetchBudgetMB="), Options.PrefetchBudgetMB);
+	FParse::Value(*Params, TEXT("-GCBudgetMB="), Options.GCBudgetMB);
+	FParse::Value(*Params, TEXT("-GCMinInterval="), Options.GCMinInterval);
+	FParse::Value(*Params, TEXT("-Stream="), Options.StreamFormat);
+	FParse::Value(*Params, TEXT("-StreamFile="), Options.StreamPath);
+	Options.bWriteTree = !FParse::Param(*Params, TEXT("NoTree"));
+	Options.bWriteBundle = FParse::Param(*Params, TEXT("Bundle"));
+	Options.bCompressBundle = FParse::Param(*Params, TEXT("BundleCompress"));
+	return Options;
+}
+
+FString FBlueprintAuditBatchOptions::ToParams() const
+{
+	// StreamPath is left out: each worker process streams to a file of its own.
+	// So is -Bundle: the bundle has a single writer, and the parent packs what the workers wrote.
+	FString Params = FString::Printf(TEXT("-Threads=%d -QueueDepth=%d -Prefetch=%d -PrefetchBudgetMB=%d -GCBudgetMB=%d -GCMinInterval=%d"),
+		NumThreads, QueueDepth, PrefetchDepth, PrefetchBudgetMB, GCBudgetMB, GCMinInterval);
+	if (!StreamFormat.IsEmpty())
+	{
+		Params += FString::Printf(TEXT(" -Stream=%s"), *StreamFormat);
+	}
+	if (!bWriteTree)
+	{
+		Params += TEXT(" -NoTree");
+	}
+	if (FBlueprintAuditor::IsPrettyJson())
+	{
+		Params += TEXT(" -Pretty");
+	}
+	if (FBlueprintAuditor::IsCompactBinaryEnabled())
+	{
+		Params += TEXT(" -CompactBinary");
+	}
+	return Params;
+}
+
+TArray<FAssetData> FBlueprintAuditBatch::GetProjectBlueprints(IAssetRegistry& AssetRegistry, int32& OutSkipCount)
+{
+	TArray<FAssetData> AllBlueprints;
+	AssetRegistry.GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), AllBlueprints, true);
+
+	// Filter: Only audit project content (starts with /Game/)
+	const int32 TotalCount = AllBlueprints.Num();
+	AllBlueprints.RemoveAll([](const FAssetData& Asset)
+	{
+		return !Asset.PackageName.ToString().StartsWith(TEXT("/Game/"));
+	});
+	OutSkipCount = TotalCount - AllBlueprints.Num();
+
+	AllBlueprints.Sort([](const FAssetData& A, const FAssetData& B)
+	{
+		return A.PackageName.LexicalLess(B.PackageName);
+	});
+	return AllBlueprints;
+}
+
+bool FBlueprintAuditBatch::ReadAssetList(const FString& Source, TArray<FString>& OutEntries)
+{
+	if (Source == TEXT("-"))
+	{
+		// Read to EOF before splitting, so a line longer than the read buffer stays one entry
+		TArray<uint8> Bytes;
+		uint8 Buffer[4096];
+		size_t ReadCount;
+		while ((ReadCount = fread(Buffer, 1, sizeof(Buffer), stdin)) > 0)
+		{
+			Bytes.Append(Buffer, static_cast<int32>(ReadCount));
+		}
+		if (ferror(stdin))
+		{
+			return false;
+		}
+
+		FString Text;
+		FFileHelper::BufferToString(Text, Bytes.GetData(), Bytes.Num());
+		Text.ParseIntoArrayLines(OutEntries, false);
+		return true;
+	}
+
+	return FFileHelper::LoadFileToStringArray(OutEntries, *Source);
+}
+
+void FBlueprintAuditBatch::ResolveAssetList(const TArray<FString>& Entries, TArray<FBlueprintAuditWorkItem>& OutItems,
+	TArray<FString>& OutMissingPackages, bool bRescanFiles)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	TSet<FString> Seen;
+	for (const FString& RawEntry : Entries)
+	{
+		const FString Entry = RawEntry.TrimStartAndEnd().TrimQuotes();
+		if (Entry.IsEmpty() || Entry.StartsWith(TEXT("#")))
+		{
+			continue;
+		}
+
+		FString PackageName;
+		if (!AssetListEntryToPackageName(Entry, PackageName))
+		{
+			UE_LOG(LogCoRider, Warning, TEXT("CoRider: Can't map asset list entry to a package: %s"), *Entry);
+			continue;
+		}
+
+		// Filter: Only audit project content (starts with /Game/)
+		bool bAlreadySeen = false;
+		Seen.Add(PackageName, &bAlreadySeen);
+		if (bAlreadySeen || !PackageName.StartsWith(TEXT("/Game/")))
+		{
+			continue;
+		}
+
+		if (bRescanFiles)
+		{
+			// The registry keeps entries for files deleted since its last scan, so check the disk first
+			const FString SourcePath = FBlueprintAuditor::GetSourceFilePath(PackageName);
+			if (SourcePath.IsEmpty() || !FPaths::FileExists(SourcePath))
+			{
+				OutMissingPackages.Add(PackageName);
+				continue;
+			}
+			AssetRegistry.ScanFilesSynchronous({ SourcePath }, true);
+		}
+
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByPackageName(FName(*PackageName), Assets, true);
+		if (Assets.IsEmpty())
+		{
+			OutMissingPackages.Add(PackageName);
+			continue;
+		}
+
+		if (const FAssetData* Blueprint = Assets.FindByPredicate([](const FAssetData& Asset)
+			{
+				return Asset.IsInstanceOf(UBlueprint::StaticClass());
+			}))
+		{
+			OutItems.Add(MakeWorkItem(*Blueprint));
+		}
+		else
+		{
+			// Still there but no longer a Blueprint (e.g. replaced by another asset type): its audit is stale all the same
+			OutMissingPackages.Add(PackageName);
+		}
+	}
+}
+
+FBlueprintAuditWorkItem FBlueprintAuditBatch::MakeWorkItem(const FAssetData& Asset)
+{
+	FBlueprintAuditWorkItem Item;
+	Item.Asset = Asset;
+	Item.PackageName = Asset.PackageName.ToString();
+	Item.SourcePath = FBlueprintAuditor::GetSourceFilePath(Item.PackageName);
+	Item.OutputPath = FBlueprintAuditor::GetAuditOutputPath(Item.PackageName);
+	return Item;
+}
+
+int32 FBlueprintAuditBatch::RemoveUpToDateItems(TArray<FBlueprintAuditWorkItem>& WorkItems)
+{
+	const double CheckStart = FPlatformTime::Seconds();
+
+	TArray<bool> UpToDate;
+	UpToDate.SetNumZeroed(WorkItems.Num());
+
+	ParallelFor(WorkItems.Num(), [&WorkItems, &UpToDate](int32 Index)
+	{
+		FBlueprintAuditWorkItem& Item = WorkItems[Index];
+		if (Item.SourcePath.IsEmpty())
+		{
+			return;
+		}
+
+		UpToDate[Index] = FBlueprintAuditor::IsAuditUpToDate(Item.PackageName, Item.SourcePath, Item.OutputPath, &Item.SourceFileHash);
+	});
+
+	TArray<FBlueprintAuditWorkItem> StaleItems;
+	for (int32 Index = 0; Index < WorkItems.Num(); ++Index)
+	{
+		if (!UpToDate[Index])
+		{
+			StaleItems.Add(MoveTemp(WorkItems[Index]));
+		}
+	}
+
+	const int32 UpToDateCount = WorkItems.Num() - StaleItems.Num();
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Up-to-date check — %d of %d up-to-date in %.2fs"),
+		UpToDateCount, WorkItems.Num(), FPlatformTime::Seconds() - CheckStart);
+
+	WorkItems = MoveTemp(StaleItems);
+	return UpToDateCount;
+}
+
+FBlueprintAuditBatchResult FBlueprintAuditBatch::Run(const TArray<FBlueprintAuditWorkItem>& WorkItems,
+	const FBlueprintAuditBatchOptions& Options, const FOnItemAudited& OnItemAudited, FBlueprintAuditCheckpoint* Checkpoint)
+{
+	FBlueprintAuditBatchResult Result;
+	const double StartTime = FPlatformTime::Seconds();
+
+	FBlueprintAuditGCPolicy GCPolicy(Options.GCBudgetMB, Options.GCMinInterval);
+
+	// Extracted audits are journaled as done only after a flush proves their writes landed
+	int32 AssetsSinceCheckpoint = 0;
+	constexpr int32 CheckpointInterval = 25;
+
+	FBlueprintAuditPipeline Pipeline(Options.NumThreads, Options.QueueDepth, Options.Stream, Options.bWriteTree, Options.Bundle);
+
+	TUniquePtr<FBlueprintAuditPrefetcher> Prefetcher;
+	if (Options.PrefetchDepth > 0)
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+		TArray<FName> PackageNames;
+		TArray<int64> PackageSizes;
+		for (const FBlueprintAuditWorkItem& Item : WorkItems)
+		{
+			const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(Item.Asset.PackageName);
+			PackageNames.Add(Item.Asset.PackageName);
+			PackageSizes.Add(PackageData.IsSet() ? FMath::Max<int64>(PackageData->DiskSize, 0) : 0);
+		}
+		Prefetcher = MakeUnique<FBlueprintAuditPrefetcher>(MoveTemp(PackageNames), MoveTemp(PackageSizes),
+			Options.PrefetchDepth, static_cast<int64>(Options.PrefetchBudgetMB) * 1024 * 1024);
+	}
+
+	for (int32 Index = 0; Index < WorkItems.Num(); ++Index)
+	{
+		const FBlueprintAuditWorkItem& Item = WorkItems[Index];
+
+		// Journaled before Wait, which flushes this item's load (and only this item's), so a crash in the load
+		// is pinned on it; the prefetch window may be loading others, but never begins them here
+		if (Checkpoint)
+		{
+			Checkpoint->MarkStarted(Item.PackageName);
+		}
+
+		const double LoadStart = FPlatformTime::Seconds();
+		if (Prefetcher)
+		{
+			Prefetcher->Wait(Index);
+		}
+
+		// Resolves in memory when prefetched; falls back to a synchronous load otherwise
+		UBlueprint* BP = Cast<UBlueprint>(Item.Asset.GetAsset());
+		Result.LoadSeconds += FPlatformTime::Seconds() - LoadStart;
+		if (!BP)
+		{
+			Result.FailedPackages.Add(Item.PackageName);
+			UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to load asset %s"), *Item.PackageName);
+			if (Checkpoint)
+			{
+				Checkpoint->MarkFailed(Item.PackageName);
+			}
+			if (Prefetcher)
+			{
+				Prefetcher->Release(Index);
+			}
+			if (OnItemAudited)
+			{
+				OnItemAudited(Item, false);
+			}
+			continue;
+		}
+
+		// UObject walk stays on the game thread; the source hash is filled in by the pipeline
+		const double ExtractStart = FPlatformTime::Seconds();
+		FBlueprintAuditWriteJob Job;
+		Job.PackageName = Item.PackageName;
+		Job.SourcePath = Item.SourcePath;
+		Job.SourceFileHash = Item.SourceFileHash;
+		Job.OutputPath = Item.OutputPath;
+		Job.Audit = FBlueprintAuditor::AuditBlueprint(BP, false);
+		Result.ExtractSeconds += FPlatformTime::Seconds() - ExtractStart;
+		++Result.ExtractedCount;
+
+		Pipeline.Enqueue(MoveTemp(Job));
+
+		if (Checkpoint)
+		{
+			Checkpoint->MarkExtracted(Item.PackageName);
+			if (++AssetsSinceCheckpoint >= CheckpointInterval)
+			{
+				Pipeline.Flush();
+				Checkpoint->CommitExtracted(Pipeline.GetFailedPackages());
+				AssetsSinceCheckpoint = 0;
+			}
+		}
+
+		if (OnItemAudited)
+		{
+			OnItemAudited(Item, true);
+		}
+
+		if (Prefetcher)
+		{
+			Prefetcher->Release(Index);
+			Prefetcher->Pump(0.005);
+		}
+
+		GCPolicy.Tick();
+	}
+
+	Pipeline.Flush();
+	if (Checkpoint)
+	{
+		Checkpoint->CommitExtracted(Pipeline.GetFailedPackages());
+	}
+
+	Result.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+	Result.WrittenCount = Pipeline.GetWrittenCount();
+	Result.UnchangedCount = Pipeline.GetUnchangedCount();
+	Result.GCCount = GCPolicy.GetCollectCount();
+	Result.GCSeconds = GCPolicy.GetCollectSeconds();
+	const int32 LoadFailCount = Result.FailedPackages.Num();
+	Result.FailedPackages.Append(Pipeline.GetFailedPackages());
+	Result.FailedPackages.Sort();
+
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Game thread — load %d in %.2fs, extract %d in %.2fs (%.1f/s)"),
+		Result.ExtractedCount + LoadFailCount, Result.LoadSeconds,
+		Result.ExtractedCount, Result.ExtractSeconds,
+		Result.ExtractSeconds > 0.0 ? Result.ExtractedCount / Result.ExtractSeconds : 0.0);
+	if (Prefetcher)
+	{
+		UE_LOG(LogCoRider, Display, TEXT("CoRider: Prefetch (depth %d, %d MB) — %.2fs waiting on loads vs %.2fs auditing, %d of %d package(s) already resident"),
+			Options.PrefetchDepth, Options.PrefetchBudgetMB, Prefetcher->GetWaitSeconds(), Result.ExtractSeconds,
+			Prefetcher->GetReadyHits(), WorkItems.Num());
+		Prefetcher.Reset();
+	}
+	Pipeline.LogSummary();
+	GCPolicy.LogSummary();
+	FBlueprintAuditHashCache::Get().Save();
+
+	return Result;
+}
+
+int32 FBlueprintAuditBatch::PackTreeIntoBundle(FBlueprintAuditBundle& Bundle, const TArray<FBlueprintAuditWorkItem>& Items, bool bReimport)
+{
+	int32 ReadCount = 0;
+	for (const FBlueprintAuditWorkItem& Item : Items)
+	{
+		if ((bReimport || !Bundle.Contains(Item.PackageName)) && Bundle.PutFile(Item.PackageName, Item.OutputPath))
+		{
+			++ReadCount;
+		}
+	}
+	return ReadCount;
+}
@@ -0,0 +1,497 @@
+#include "BlueprintAuditBundle.h"
+
+#include "BlueprintAuditor.h"
+#include "BlueprintAuditFileLock.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/xxhash.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+static constexpr uint32 BundleMagic = 0x42415243; // "CRAB"
+static constexpr uint32 BundleFormatVersion = 1;
+static constexpr int64 BundleHeaderSize = 32;
+static constexpr int64 BundleEntrySize = 40;
+
+/** Compaction waits until this much dead space has piled up, whatever the live size. */
+static constexpr int64 BundleMinCompactBytes = 1024 * 1024;
+
+struct FBundleHeader
+{
+	uint32 Magic = BundleMagic;
+	uint32 FormatVersion = BundleFormatVersion;
+	int32 SchemaVersion = FBlueprintAuditor::AuditSchemaVersion;
+	uint32 EntryCount = 0;
+	uint64 IndexOffset = BundleHeaderSize;
+	uint64 IndexSize = 0;
+
+	void Serialize(FArchive& Ar)
+	{
+		Ar << Magic << FormatVersion << SchemaVersion << EntryCount << IndexOffset << IndexSize;
+	}
+};
+
+static bool WriteAt(IFileHandle& Handle, int64 Offset, const TArray<uint8>& Bytes)
+{
+	return Handle.Seek(Offset) && Handle.Write(Bytes.GetData(), Bytes.Num());
+}
+
+/** Byte order of UTF-8 package names; the index is sorted by it and readers search by it. */
+static int32 CompareNames(TConstArrayView<uint8> A, TConstArrayView<uint8> B)
+{
+	const int32 Common = FMath::Min(A.Num(), B.Num());
+	const int32 Result = Common > 0 ? FMemory::Memcmp(A.GetData(), B.GetData(), Common) : 0;
+	return Result != 0 ? Result : A.Num() - B.Num();
+}
+
+static TArray<uint8> ToUtf8(const FString& Value)
+{
+	const FTCHARToUTF8 Utf8(*Value);
+	return TArray<uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+}
+
+// --- Writer ---
+
+FString FBlueprintAuditBundle::GetDefaultPath()
+{
+	return FBlueprintAuditor::GetAuditVersionDir() / TEXT("Blueprints.bundle");
+}
+
+FBlueprintAuditBundle::FBlueprintAuditBundle(const FString& InPath, bool bInCompress)
+	: Path(InPath)
+	, bCompress(bInCompress)
+{
+}
+
+FBlueprintAuditBundle::~FBlueprintAuditBundle()
+{
+	FileHandle.Reset();
+	WriterLock.Reset();
+}
+
+TSharedPtr<FBlueprintAuditBundle> FBlueprintAuditBundle::Open(const FString& Path, bool bCompress)
+{
+	TSharedPtr<FBlueprintAuditBundle> Bundle = MakeShareable(new FBlueprintAuditBundle(Path, bCompress));
+
+	// Share modes only exclude a second writer on Windows; the lock does it everywhere, and before the index is read
+	Bundle->WriterLock = MakeUnique<FBlueprintAuditFileLock>(Path + TEXT(".lock"));
+	if (!Bundle->WriterLock->IsLocked())
+	{
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: Bundle %s is being written by another process — skipping it"), *Path);
+		return nullptr;
+	}
+
+	// Load the existing index, then drop the mapping before the file is opened for writing
+	bool bAppend = false;
+	if (TUniquePtr<FBlueprintAuditBundleReader> Reader = FBlueprintAuditBundleReader::Open(Path))
+	{
+		Bundle->Entries.Reserve(Reader->Num());
+		for (int32 Index = 0; Index < Reader->Num(); ++Index)
+		{
+			FBlueprintAuditBundleEntry Entry = Reader->GetEntry(Index);
+			Bundle->LiveBytes += Entry.StoredSize;
+			Bundle->Entries.Add(Entry.PackageName, MoveTemp(Entry));
+		}
+		bAppend = true;
+	}
+	else if (IFileManager::Get().FileSize(*Path) >= 0)
+	{
+		UE_LOG(LogCoRider, Display, TEXT("CoRider: Bundle %s is from another schema version or unreadable — starting over"), *Path);
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Path));
+	Bundle->FileHandle.Reset(PlatformFile.OpenWrite(*Path, bAppend, true));
+	if (!Bundle->FileHandle)
+	{
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to open bundle %s for writing (in use by another process?) — skipping it"), *Path);
+		return nullptr;
+	}
+
+	if (bAppend)
+	{
+		Bundle->EndOffset = Bundle->FileHandle->Size();
+	}
+	else
+	{
+		// An empty but valid bundle, so readers never see a half-initialized file
+		TArray<uint8> HeaderBytes;
+		FMemoryWriter HeaderWriter(HeaderBytes);
+		FBundleHeader().Serialize(HeaderWriter);
+		if (!WriteAt(*Bundle->FileHandle, 0, HeaderBytes))
+		{
+			UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to initialize bundle %s — skipping it"), *Path);
+			return nullptr;
+		}
+		Bundle->EndOffset = BundleHeaderSize;
+	}
+	return Bundle;
+}
+
+bool FBlueprintAuditBundle::Put(const FString& PackageName, TConstArrayView<uint8> Json)
+{
+	const uint64 Hash = FXxHash64::HashBuffer(Json.GetData(), Json.Num()).Hash;
+
+	// Compression happens outside the lock; pipeline threads put concurrently
+	TArray<uint8> Compressed;
+	uint8 Compression = 0;
+	if (bCompress && Json.Num() > 0)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Json.Num());
+		Compressed.SetNumUninitialized(CompressedSize);
+		if (FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Json.GetData(), Json.Num())
+			&& CompressedSize < Json.Num())
+		{
+			Compressed.SetNum(CompressedSize);
+			Compression = 1;
+		}
+	}
+	const uint8* StoredData = Compression ? Compressed.GetData() : Json.GetData();
+	const int64 StoredSize = Compression ? Compressed.Num() : Json.Num();
+
+	FScopeLock ScopeLock(&Lock);
+	if (const FBlueprintAuditBundleEntry* Existing = Entries.Find(PackageName))
+	{
+		if (Existing->Hash == Hash && Existing->RawSize == static_cast<uint32>(Json.Num()))
+		{
+			++UnchangedCount;
+			return true;
+		}
+	}
+
+	if (!FileHandle || !FileHandle->Seek(EndOffset) || !FileHandle->Write(StoredData, StoredSize))
+	{
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to append %s to bundle %s"), *PackageName, *Path);
+		return false;
+	}
+
+	FBlueprintAuditBundleEntry& Entry = Entries.FindOrAdd(PackageName);
+	LiveBytes -= Entry.StoredSize;
+	Entry.PackageName = PackageName;
+	Entry.Offset = EndOffset;
+	Entry.StoredSize = static_cast<uint32>(StoredSize);
+	Entry.RawSize = static_cast<uint32>(Json.Num());
+	Entry.Hash = Hash;
+	Entry.Compression = Compression;
+	LiveBytes += StoredSize;
+	EndOffset += StoredSize;
+
+	++AppendedCount;
+	bDirty = true;
+	return true;
+}
+
+bool FBlueprintAuditBundle::PutFile(const FString& PackageName, const FString& JsonPath)
+{
+	TArray<uint8> Json;
+	return FFileHelper::LoadFileToArray(Json, *JsonPath, FILEREAD_Silent) && Put(PackageName, Json);
+}
+
+int32 FBlueprintAuditBundle::Num() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Entries.Num();
+}
+
+bool FBlueprintAuditBundle::Contains(const FString& PackageName) const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Entries.Contains(PackageName);
+}
+
+void FBlueprintAuditBundle::Remove(const FString& PackageName)
+{
+	FScopeLock ScopeLock(&Lock);
+	FBlueprintAuditBundleEntry Removed;
+	if (Entries.RemoveAndCopyValue(PackageName, Removed))
+	{
+		LiveBytes -= Removed.StoredSize;
+		bDirty = true;
+	}
+}
+
+int32 FBlueprintAuditBundle::RemoveAllExcept(const TSet<FString>& LivePackages)
+{
+	FScopeLock ScopeLock(&Lock);
+	int32 RemovedCount = 0;
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (!LivePackages.Contains(It.Key()))
+		{
+			LiveBytes -= It.Value().StoredSize;
+			It.RemoveCurrent();
+			++RemovedCount;
+		}
+	}
+	bDirty |= RemovedCount > 0;
+	return RemovedCount;
+}
+
+bool FBlueprintAuditBundle::Commit()
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!bDirty)
+	{
+		return true;
+	}
+	if (!FileHandle)
+	{
+		return false;
+	}
+
+	TArray<TPair<TArray<uint8>, const FBlueprintAuditBundleEntry*>> Named;
+	Named.Reserve(Entries.Num());
+	for (const TPair<FString, FBlueprintAuditBundleEntry>& Pair : Entries)
+	{
+		Named.Emplace(ToUtf8(Pair.Key), &Pair.Value);
+	}
+	Named.Sort([](const auto& A, const auto& B) { return CompareNames(A.Key, B.Key) < 0; });
+
+	TArray<const FBlueprintAuditBundleEntry*> Sorted;
+	Sorted.Reserve(Named.Num());
+	for (const auto& Pair : Named)
+	{
+		Sorted.Add(Pair.Value);
+	}
+
+	// Old records and every previous index are dead once superseded
+	const int64 DeadBytes = EndOffset - BundleHeaderSize - LiveBytes;
+	const bool bCompacted = DeadBytes > LiveBytes && DeadBytes > BundleMinCompactBytes && Compact(Sorted);
+	if (!FileHandle || (!bCompacted && !WriteIndexAndHeader(*FileHandle, EndOffset, Sorted)))
+	{
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to commit bundle %s"), *Path);
+		return false;
+	}
+
+	FileHandle->Flush();
+	bDirty = false;
+	UE_LOG(LogCoRider, Verbose, TEXT("CoRider: Committed bundle %s — %d record(s), %.1f MB"),
+		*Path, Entries.Num(), EndOffset / (1024.0 * 1024.0));
+	return true;
+}
+
+bool FBlueprintAuditBundle::WriteIndexAndHeader(IFileHandle& Handle, int64& InOutEndOffset, const TArray<const FBlueprintAuditBundleEntry*>& Sorted)
+{
+	TArray<uint8> Names;
+	TArray<uint8> IndexBytes;
+	FMemoryWriter IndexWriter(IndexBytes);
+	for (const FBlueprintAuditBundleEntry* Entry : Sorted)
+	{
+		const TArray<uint8> Name = ToUtf8(Entry->PackageName);
+		uint32 NameOffset = Names.Num();
+		uint32 NameLength = Name.Num();
+		uint64 Offset = Entry->Offset;
+		uint32 StoredSize = Entry->StoredSize;
+		uint32 RawSize = Entry->RawSize;
+		uint64 Hash = Entry->Hash;
+		uint8 Compression = Entry->Compression;
+		uint8 Padding[7] = {};
+		IndexWriter << NameOffset << NameLength << Offset << StoredSize << RawSize << Hash << Compression;
+		IndexWriter.Serialize(Padding, sizeof(Padding));
+		Names.Append(Name);
+	}
+	IndexBytes.Append(Names);
+
+	FBundleHeader Header;
+	Header.EntryCount = Sorted.Num();
+	Header.IndexOffset = InOutEndOffset;
+	Header.IndexSize = IndexBytes.Num();
+	TArray<uint8> HeaderBytes;
+	FMemoryWriter HeaderWriter(HeaderBytes);
+	Header.Serialize(HeaderWriter);
+
+	// Index first: until the header moves to it, readers keep using the previous one
+	if (!WriteAt(Handle, InOutEndOffset, IndexBytes) || !Handle.Flush() || !WriteAt(Handle, 0, HeaderBytes))
+	{
+		return false;
+	}
+	InOutEndOffset += IndexBytes.Num();
+	return true;
+}
+
+bool FBlueprintAuditBundle::Compact(const TArray<const FBlueprintAuditBundleEntry*>& Sorted)
+{
+	const FString TempPath = FBlueprintAuditor::MakeTempFilePath(Path);
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TUniquePtr<IFileHandle> TempHandle(PlatformFile.OpenWrite(*TempPath, false, true));
+	if (!TempHandle)
+	{
+		return false;
+	}
+
+	const int64 OldSize = EndOffset;
+	TArray<FBlueprintAuditBundleEntry> Compacted;
+	Compacted.Reserve(Sorted.Num());
+	int64 NewEndOffset = BundleHeaderSize;
+	TArray<uint8> Record;
+	bool bOk = TempHandle->Seek(NewEndOffset);
+	for (const FBlueprintAuditBundleEntry* Entry : Sorted)
+	{
+		if (!bOk)
+		{
+			break;
+		}
+		Record.SetNumUninitialized(Entry->StoredSize);
+		bOk = FileHandle->Seek(Entry->Offset) && FileHandle->Read(Record.GetData(), Record.Num())
+			&& TempHandle->Write(Record.GetData(), Record.Num());
+
+		FBlueprintAuditBundleEntry& Moved = Compacted.Add_GetRef(*Entry);
+		Moved.Offset = NewEndOffset;
+		NewEndOffset += Entry->StoredSize;
+	}
+
+	TArray<const FBlueprintAuditBundleEntry*> CompactedSorted;
+	for (const FBlueprintAuditBundleEntry& Entry : Compacted)
+	{
+		CompactedSorted.Add(&Entry);
+	}
+	bOk = bOk && WriteIndexAndHeader(*TempHandle, NewEndOffset, CompactedSorted) && TempHandle->Flush();
+	TempHandle.Reset();
+
+	if (!bOk)
+	{
+		PlatformFile.DeleteFile(*TempPath);
+		return false;
+	}
+
+	// Swap files; the handle is reopened on whichever one ends up at Path, so a failed move keeps the old bundle usable
+	FileHandle.Reset();
+	const bool bMoved = FBlueprintAuditor::ReplaceFile(Path, TempPath);
+	FileHandle.Reset(PlatformFile.OpenWrite(*Path, true, true));
+	if (!bMoved)
+	{
+		PlatformFile.DeleteFile(*TempPath);
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to replace bundle %s with its compacted copy"), *Path);
+		return false;
+	}
+
+	for (FBlueprintAuditBundleEntry& Entry : Compacted)
+	{
+		Entries.FindChecked(Entry.PackageName) = MoveTemp(Entry);
+	}
+	EndOffset = NewEndOffset;
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Compacted bundle %s — %.1f MB -> %.1f MB"),
+		*Path, OldSize / (1024.0 * 1024.0), EndOffset / (1024.0 * 1024.0));
+	return true;
+}
+
+// --- Reader ---
+
+TUniquePtr<FBlueprintAuditBundleReader> FBlueprintAuditBundleReader::Open(const FString& Path)
+{
+	TUniquePtr<FBlueprintAuditBundleReader> Reader(new FBlueprintAuditBundleReader());
+	Reader->MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Path));
+	if (!Reader->MappedFile || Reader->MappedFile->GetFileSize() < BundleHeaderSize)
+	{
+		return nullptr;
+	}
+
+	Reader->Size = Reader->MappedFile->GetFileSize();
+	Reader->MappedRegion.Reset(Reader->MappedFile->MapRegion(0, Reader->Size));
+	if (!Reader->MappedRegion)
+	{
+		return nullptr;
+	}
+	Reader->Data = Reader->MappedRegion->GetMappedPtr();
+
+	FBundleHeader Header;
+	FMemoryReaderView HeaderReader(MakeArrayView(Reader->Data, BundleHeaderSize));
+	Header.Serialize(HeaderReader);
+	if (Header.Magic != BundleMagic || Header.FormatVersion != BundleFormatVersion
+		|| Header.SchemaVersion != FBlueprintAuditor::AuditSchemaVersion
+		|| Header.IndexOffset + Header.IndexSize > static_cast<uint64>(Reader->Size)
+		|| Header.EntryCount * static_cast<uint64>(BundleEntrySize) > Header.IndexSize)
+	{
+		return nullptr;
+	}
+
+	Reader->EntryCount = Header.EntryCount;
+	Reader->IndexOffset = Header.IndexOffset;
+	return Reader;
+}
+
+FBlueprintAuditBundleReader::~FBlueprintAuditBundleReader()
+{
+	// The region must go before the handle it was mapped from
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+FBlueprintAuditBundleEntry FBlueprintAuditBundleReader::GetEntry(int32 Index) const
+{
+	FBlueprintAuditBundleEntry Entry;
+	FMemoryReaderView EntryReader(MakeArrayView(Data + IndexOffset + Index * BundleEntrySize, BundleEntrySize));
+	uint32 NameOffset = 0;
+	uint32 NameLength = 0;
+	EntryReader << NameOffset << NameLength << Entry.Offset << Entry.StoredSize << Entry.RawSize << Entry.Hash << Entry.Compression;
+
+	const TConstArrayView<uint8> Name = GetEntryName(Index);
+	Entry.PackageName = FString(FUTF8ToTCHAR(reinterpret_cast<const UTF8CHAR*>(Name.GetData()), Name.Num()));
+	return Entry;
+}
+
+TConstArrayView<uint8> FBlueprintAuditBundleReader::GetEntryName(int32 Index) const
+{
+	const uint8* EntryData = Data + IndexOffset + Index * BundleEntrySize;
+	uint32 NameOffset = 0;
+	uint32 NameLength = 0;
+	FMemory::Memcpy(&NameOffset, EntryData, sizeof(NameOffset));
+	FMemory::Memcpy(&NameLength, EntryData + sizeof(NameOffset), sizeof(NameLength));
+
+	const uint64 NamesStart = IndexOffset + EntryCount * static_cast<uint64>(BundleEntrySize);
+	if (NamesStart + NameOffset + NameLength > static_cast<uint64>(Size))
+	{
+		return TConstArrayView<uint8>();
+	}
+	return MakeArrayView(Data + NamesStart + NameOffset, NameLength);
+}
+
+bool FBlueprintAuditBundleReader::Find(const FString& PackageName, FBlueprintAuditBundleEntry& OutEntry) const
+{
+	const TArray<uint8> Name = ToUtf8(PackageName);
+	int32 Low = 0;
+	int32 High = EntryCount - 1;
+	while (Low <= High)
+	{
+		const int32 Mid = Low + (High - Low) / 2;
+		const int32 Order = CompareNames(GetEntryName(Mid), Name);
+		if (Order == 0)
+		{
+			OutEntry = GetEntry(Mid);
+			return true;
+		}
+		if (Order < 0)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid - 1;
+		}
+	}
+	return false;
+}
+
+bool FBlueprintAuditBundleReader::ReadRecord(const FBlueprintAuditBundleEntry& Entry, TArray<uint8>& OutJson) const
+{
+	if (Entry.Offset + Entry.StoredSize > static_cast<uint64>(Size))
+	{
+		return false;
+	}
+
+	const uint8* Stored = Data + Entry.Offset;
+	if (Entry.Compression == 0)
+	{
+		OutJson = TArray<uint8>(Stored, Entry.StoredSize);
+		return true;
+	}
+
+	OutJson.SetNumUninitialized(Entry.RawSize);
+	return Entry.Compression == 1
+		&& FCompression::UncompressMemory(NAME_Zlib, OutJson.GetData(), Entry.RawSize, Stored, Entry.StoredSize);
+}
@@ -0,0 +1,173 @@
+#include "BlueprintAuditCheckpoint.h"
+
+#include "BlueprintAuditor.h"
+#include "HAL/FileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+FBlueprintAuditCheckpoint::FBlueprintAuditCheckpoint(const FString& Name, const TArray<FBlueprintAuditWorkItem>& WorkItems, const FString& Directory)
+	: JournalPath((Directory.IsEmpty() ? FBlueprintAuditor::GetAuditVersionDir() / TEXT("Checkpoints") : Directory) / Name + TEXT(".journal"))
+{
+	uint32 Crc = 0;
+	for (const FBlueprintAuditWorkItem& Item : WorkItems)
+	{
+		Crc = FCrc::StrCrc32(*Item.PackageName, Crc);
+	}
+	Fingerprint = FString::Printf(TEXT("%08x-%d"), Crc, WorkItems.Num());
+}
+
+FBlueprintAuditCheckpoint::~FBlueprintAuditCheckpoint()
+{
+	// Left on disk on purpose: a run that never reached Finish() is what -Resume picks up
+	Writer.Reset();
+}
+
+bool FBlueprintAuditCheckpoint::Open(bool bResume)
+{
+	TArray<FString> Lines;
+	bool bResuming = bResume && FFileHelper::LoadFileToStringArray(Lines, *JournalPath)
+		&& Lines.Num() > 0 && Lines[0] == TEXT("fingerprint ") + Fingerprint;
+
+	if (bResume && !bResuming && Lines.Num() > 0)
+	{
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: Checkpoint %s was recorded for a different work list — starting over"), *JournalPath);
+	}
+
+	TArray<FString> Crashed;
+	if (bResuming)
+	{
+		for (const TPair<FString, FString>& Entry : ReadStates(JournalPath))
+		{
+			if (Entry.Value == TEXT("done"))
+			{
+				Completed.Add(Entry.Key);
+			}
+			else if (Entry.Value == TEXT("quarantined"))
+			{
+				Quarantined.Add(Entry.Key);
+			}
+			else if (Entry.Value == TEXT("begin"))
+			{
+				// Started but never extracted: this is what took the process down
+				Crashed.Add(Entry.Key);
+			}
+		}
+	}
+
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*JournalPath,
+		bResuming ? FILEWRITE_Append | FILEWRITE_AllowRead : FILEWRITE_AllowRead));
+	if (!Writer)
+	{
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to open checkpoint %s — this run can't be resumed"), *JournalPath);
+		return bResuming;
+	}
+
+	if (!bResuming)
+	{
+		Append(TEXT("fingerprint"), Fingerprint);
+		return false;
+	}
+
+	for (const FString& PackageName : Crashed)
+	{
+		UE_LOG(LogCoRider, Error, TEXT("CoRider: Quarantining %s — it crashed the previous run"), *PackageName);
+		Append(TEXT("quarantined"), PackageName);
+	}
+	Quarantined.Append(Crashed);
+	Quarantined.Sort();
+
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Resuming from %s — %d done, %d quarantined"),
+		*JournalPath, Completed.Num(), Quarantined.Num());
+	return true;
+}
+
+int32 FBlueprintAuditCheckpoint::RemoveResolvedItems(TArray<FBlueprintAuditWorkItem>& WorkItems) const
+{
+	const TSet<FString> QuarantinedSet(Quarantined);
+	int32 CompletedCount = 0;
+	WorkItems.RemoveAll([this, &QuarantinedSet, &CompletedCount](const FBlueprintAuditWorkItem& Item)
+	{
+		if (Completed.Contains(Item.PackageName))
+		{
+			++CompletedCount;
+			return true;
+		}
+		return QuarantinedSet.Contains(Item.PackageName);
+	});
+	return CompletedCount;
+}
+
+void FBlueprintAuditCheckpoint::MarkStarted(const FString& PackageName)
+{
+	Append(TEXT("begin"), PackageName);
+}
+
+void FBlueprintAuditCheckpoint::MarkFailed(const FString& PackageName)
+{
+	Append(TEXT("failed"), PackageName);
+}
+
+void FBlueprintAuditCheckpoint::MarkExtracted(const FString& PackageName)
+{
+	Append(TEXT("extracted"), PackageName);
+	Extracted.Add(PackageName);
+}
+
+void FBlueprintAuditCheckpoint::CommitExtracted(const TArray<FString>& FailedPackages)
+{
+	const TSet<FString> FailedSet(FailedPackages);
+	for (const FString& PackageName : Extracted)
+	{
+		Append(FailedSet.Contains(PackageName) ? TEXT("failed") : TEXT("done"), PackageName);
+	}
+	Extracted.Reset();
+}
+
+void FBlueprintAuditCheckpoint::MarkDone(const FString& PackageName)
+{
+	Append(TEXT("done"), PackageName);
+}
+
+void FBlueprintAuditCheckpoint::MarkQuarantined(const FString& PackageName)
+{
+	Append(TEXT("quarantined"), PackageName);
+}
+
+void FBlueprintAuditCheckpoint::Finish()
+{
+	Writer.Reset();
+	IFileManager::Get().Delete(*JournalPath, false, false, true);
+}
+
+TMap<FString, FString> FBlueprintAuditCheckpoint::ReadStates(const FString& JournalPath)
+{
+	TArray<FString> Lines;
+	FFileHelper::LoadFileToStringArray(Lines, *JournalPath);
+
+	// Last state wins; lines are appended in order. Line 0 is the fingerprint.
+	TMap<FString, FString> States;
+	for (int32 Index = 1; Index < Lines.Num(); ++Index)
+	{
+		FString State;
+		FString PackageName;
+		if (Lines[Index].Split(TEXT(" "), &State, &PackageName))
+		{
+			States.Add(PackageName, State);
+		}
+	}
+	return States;
+}
+
+void FBlueprintAuditCheckpoint::Append(const TCHAR* State, const FString& PackageName)
+{
+	if (!Writer)
+	{
+		return;
+	}
+
+	// Flushed per line so the journal survives a hard crash right after it
+	const FTCHARToUTF8 Line(*FString::Printf(TEXT("%s %s\n"), State, *PackageName));
+	Writer->Serialize(const_cast<ANSICHAR*>(Line.Get()), Line.Length());
+	Writer->Flush();
+}
@@ -1,10 +1,19 @@
 #include "BlueprintAuditCommandlet.h"
 
 #include "BlueprintAuditor.h"
+#include "BlueprintAuditBatch.h"
+#include "BlueprintAuditBundle.h"
+#include "BlueprintAuditCheckpoint.h"
+#include "BlueprintAuditDaemon.h"
+#include "BlueprintAuditHashCache.h"
+#include "BlueprintAuditShard.h"
+#include "BlueprintAuditStream.h"
+#include "BlueprintAuditWorkers.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Engine/Blueprint.h"
+#include "HAL/IConsoleManager.h"
 #include "Misc/FileHelper.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
@@ -26,6 +35,24 @@ int32 UBlueprintAuditCommandlet::Main(const FString& Params)
 	FString OutputPath;
 	FParse::Value(*Params, TEXT("-Output="), OutputPath);
 
+	// Every audit this process writes is indented; -Workers children inherit it through ToParams
+	if (FParse::Param(*Params, TEXT("Pretty")))
+	{
+		if (IConsoleVariable* PrettyJson = IConsoleManager::Get().FindConsoleVariable(TEXT("CoRider.Audit.PrettyJson")))
+		{
+			PrettyJson->Set(true, ECVF_SetByCommandline);
+		}
+	}
+
+	// Same for the Compact Binary sibling of each audit
+	if (FParse::Param(*Params, TEXT("CompactBinary")))
+	{
+		if (IConsoleVariable* CompactBinary = IConsoleManager::Get().FindConsoleVariable(TEXT("CoRider.Audit.CompactBinary")))
+		{
+			CompactBinary->Set(true, ECVF_SetByCommandline);
+		}
+	}
+
 	// Initialize asset registry
 	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
@@ -57,69 +84,264 @@ int32 UBlueprintAuditCommandlet::Main(const FString& Params)
 		UE_LOG(LogCoRider, Display, TEXT("CoRider: Auditing 1 Blueprint..."));
 
 		const double StartTime = FPlatformTime::Seconds();
-		TSharedPtr<FJsonObject> AuditJson = FBlueprintAuditor::AuditBlueprint(BP);
-		if (!FBlueprintAuditor::WriteAuditJson(AuditJson, OutputPath))
+		const FBlueprintAuditData Audit = FBlueprintAuditor::AuditBlueprint(BP);
+		if (!FBlueprintAuditor::WriteAuditJson(Audit, OutputPath))
 		{
 			return 1;
 		}
+		FBlueprintAuditHashCache::Get().Save();
 		const double Elapsed = FPlatformTime::Seconds() - StartTime;
 
 		UE_LOG(LogCoRider, Display, TEXT("CoRider: Audit complete — wrote %s in %.2fs"), *OutputPath, Elapsed);
 		return 0;
 	}
 
+	FBlueprintAuditBatchOptions BatchOptions = FBlueprintAuditBatchOptions::FromParams(Params);
+	if (!BatchOptions.StreamFormat.IsEmpty() && BatchOptions.StreamFormat != TEXT("ndjson"))
+	{
+		UE_LOG(LogCoRider, Error, TEXT("CoRider: Unsupported -Stream=%s (expected ndjson)"), *BatchOptions.StreamFormat);
+		return 1;
+	}
+
+	// --- Worker mode: a child of -Workers=N claiming batches from the parent's queue ---
+	FString WorkerQueueDir;
+	if (FParse::Value(*Params, TEXT("-WorkerQueue="), WorkerQueueDir))
+	{
+		int32 WorkerId = 0;
+		FParse::Value(*Params, TEXT("-WorkerId="), WorkerId);
+		return FBlueprintAuditWorkers::RunWorker(WorkerQueueDir, WorkerId, BatchOptions);
+	}
+
+	// -Stream=ndjson emits every audit as one line to -StreamFile (or its default file) as soon as it is written
+	if (!BatchOptions.StreamFormat.IsEmpty())
+	{
+		BatchOptions.Stream = FBlueprintAuditStream::Open(BatchOptions.StreamPath);
+		if (!BatchOptions.Stream)
+		{
+			return 1;
+		}
+	}
+
+	// -Bundle also packs every audit into one memory-mappable file next to the tree. It has a single writer,
+	// so a bundle held by another process (e.g. the editor) is skipped rather than waited for.
+	if (BatchOptions.bWriteBundle)
+	{
+		BatchOptions.Bundle = FBlueprintAuditBundle::Open(FBlueprintAuditBundle::GetDefaultPath(), BatchOptions.bCompressBundle);
+	}
+
+	// --- Daemon mode: stay resident and take audit jobs over local HTTP ---
+	if (FParse::Param(*Params, TEXT("Daemon")))
+	{
+		double IdleTimeoutSeconds = 600.0;
+		FParse::Value(*Params, TEXT("-IdleTimeout="), IdleTimeoutSeconds);
+
+		FBlueprintAuditDaemon Daemon(BatchOptions, IdleTimeoutSeconds);
+		return Daemon.Run();
+	}
+
+	// --- Merge mode: combine -Shard manifests into a completeness report ---
+	int32 MergeShardCount = 0;
+	if (FParse::Value(*Params, TEXT("-MergeShards="), MergeShardCount) || FParse::Param(*Params, TEXT("MergeShards")))
+	{
+		int32 IgnoredSkipCount = 0;
+		TArray<FString> ExpectedPackages;
+		TArray<FBlueprintAuditWorkItem> ExpectedItems;
+		for (const FAssetData& Asset : FBlueprintAuditBatch::GetProjectBlueprints(AssetRegistry, IgnoredSkipCount))
+		{
+			ExpectedPackages.Add(Asset.PackageName.ToString());
+			ExpectedItems.Add(FBlueprintAuditBatch::MakeWorkItem(Asset));
+		}
+
+		// Shards only write the tree; the bundle is packed from it once they are all in
+		if (BatchOptions.Bundle)
+		{
+			FBlueprintAuditBatch::PackTreeIntoBundle(*BatchOptions.Bundle, ExpectedItems, true);
+			BatchOptions.Bundle->RemoveAllExcept(TSet<FString>(ExpectedPackages));
+			BatchOptions.Bundle->Commit();
+			UE_LOG(LogCoRider, Display, TEXT("CoRider: Bundle — %d appended, %d unchanged"),
+				BatchOptions.Bundle->GetAppendedCount(), BatchOptions.Bundle->GetUnchangedCount());
+		}
+		return FBlueprintAuditShard::MergeManifests(ExpectedPackages, MergeShardCount);
+	}
+
 	// --- All-assets mode: write per-file JSONs under Saved/Audit/Blueprints/ ---
-	TArray<FAssetData> AllBlueprints;
-	AssetRegistry.GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), AllBlueprints, true);
 
-	UE_LOG(LogCoRider, Display, TEXT("CoRider: Auditing %d Blueprint(s)..."), AllBlueprints.Num());
+	// -Shard=i/N audits only the i-th of N deterministic slices and writes a shard manifest
+	FBlueprintAuditShard Shard;
+	FString ShardSpec;
+	const bool bSharded = FParse::Value(*Params, TEXT("-Shard="), ShardSpec);
+	if (bSharded && !FBlueprintAuditShard::Parse(ShardSpec, Shard))
+	{
+		UE_LOG(LogCoRider, Error, TEXT("CoRider: Invalid -Shard=%s (expected i/N with 0 <= i < N)"), *ShardSpec);
+		return 1;
+	}
+	if (bSharded && BatchOptions.Bundle)
+	{
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: -Bundle is ignored with -Shard — pack the bundle with -MergeShards -Bundle once every shard is done"));
+		BatchOptions.Bundle.Reset();
+	}
+
+	// -Incremental skips Blueprints whose stored SourceFileHash still matches, without loading them
+	const bool bIncremental = FParse::Param(*Params, TEXT("Incremental"));
+
+	// -Workers=N spreads the audit over N child commandlet processes
+	int32 NumWorkers = 0;
+	FParse::Value(*Params, TEXT("-Workers="), NumWorkers);
+	int32 WorkerBatchSize = 0;
+	FParse::Value(*Params, TEXT("-BatchSize="), WorkerBatchSize);
+
+	// -Resume continues from the checkpoint journal an interrupted run with the same work list left behind
+	const bool bResume = FParse::Param(*Params, TEXT("Resume"));
+
+	// -AssetList=<file> (or - for stdin) audits only the listed packages, e.g. the output of git diff --name-only
+	FString AssetListSource;
+	const bool bFromAssetList = FParse::Value(*Params, TEXT("-AssetList="), AssetListSource);
 
 	const double StartTime = FPlatformTime::Seconds();
-	int32 SuccessCount = 0;
 	int32 SkipCount = 0;
-	int32 FailCount = 0;
-
-	int32 AssetsSinceGC = 0;
-	constexpr int32 GCInterval = 50;
+	int32 SweptCount = 0;
 
-	for (const FAssetData& Asset : AllBlueprints)
+	TArray<FBlueprintAuditWorkItem> WorkItems;
+	if (bFromAssetList)
 	{
-		// Filter: Only audit project content (starts with /Game/)
-		if (!Asset.PackageName.ToString().StartsWith(TEXT("/Game/")))
+		TArray<FString> Entries;
+		if (!FBlueprintAuditBatch::ReadAssetList(AssetListSource, Entries))
 		{
-			++SkipCount;
-			continue;
+			UE_LOG(LogCoRider, Error, TEXT("CoRider: Failed to read asset list %s"), *AssetListSource);
+			return 1;
 		}
 
-		UBlueprint* BP = Cast<UBlueprint>(Asset.GetAsset());
-		if (!BP)
+		// Listed packages the registry no longer has were deleted or renamed; drop their stale JSON
+		TArray<FString> MissingPackages;
+		FBlueprintAuditBatch::ResolveAssetList(Entries, WorkItems, MissingPackages);
+		for (const FString& PackageName : MissingPackages)
 		{
-			++FailCount;
-			UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to load asset %s"), *Asset.PackageName.ToString());
-			continue;
+			const FString JsonPath = FBlueprintAuditor::GetAuditOutputPath(PackageName);
+			if (FPaths::FileExists(JsonPath) && FBlueprintAuditor::DeleteAuditJson(JsonPath))
+			{
+				++SweptCount;
+			}
+			if (BatchOptions.Bundle)
+			{
+				BatchOptions.Bundle->Remove(PackageName);
+			}
 		}
 
-		const FString PerFilePath = FBlueprintAuditor::GetAuditOutputPath(BP);
-		TSharedPtr<FJsonObject> AuditJson = FBlueprintAuditor::AuditBlueprint(BP);
-		if (FBlueprintAuditor::WriteAuditJson(AuditJson, PerFilePath))
+		UE_LOG(LogCoRider, Display, TEXT("CoRider: Asset list resolved %d Blueprint(s) and %d removed package(s) from %d entries"),
+			WorkItems.Num(), MissingPackages.Num(), Entries.Num());
+	}
+	else
+	{
+		for (const FAssetData& Asset : FBlueprintAuditBatch::GetProjectBlueprints(AssetRegistry, SkipCount))
 		{
-			++SuccessCount;
+			WorkItems.Add(FBlueprintAuditBatch::MakeWorkItem(Asset));
 		}
-		else
+	}
+
+	const int32 CandidateCount = WorkItems.Num();
+	if (bSharded)
+	{
+		WorkItems.RemoveAll([&Shard](const FBlueprintAuditWorkItem& Item)
 		{
-			++FailCount;
-			UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to write audit for %s"), *BP->GetName());
+			return !Shard.Contains(Item.PackageName);
+		});
+	}
+
+	// Recorded before the incremental filter: up-to-date packages still count as covered by this shard
+	TArray<FString> AssignedPackages;
+	if (bSharded)
+	{
+		Shard.DeleteManifest();
+		for (const FBlueprintAuditWorkItem& Item : WorkItems)
+		{
+			AssignedPackages.Add(Item.PackageName);
 		}
+		UE_LOG(LogCoRider, Display, TEXT("CoRider: Shard %d/%d owns %d of %d Blueprint(s)"),
+			Shard.Index, Shard.Count, WorkItems.Num(), CandidateCount);
+	}
+
+	// Resumed and up-to-date packages are dropped from the work list below but still belong in the bundle
+	TArray<FBlueprintAuditWorkItem> BundleItems;
+	if (BatchOptions.Bundle)
+	{
+		BundleItems = WorkItems;
+	}
+
+	// Every batch run keeps a journal; -Resume decides whether an existing one is honoured
+	const FString CheckpointName = bSharded ? FString::Printf(TEXT("shard-%d-of-%d"), Shard.Index, Shard.Count)
+		: bFromAssetList ? TEXT("asset-list") : TEXT("all");
+	FBlueprintAuditCheckpoint Checkpoint(CheckpointName, WorkItems);
+	int32 ResumedCount = 0;
+	if (Checkpoint.Open(bResume))
+	{
+		ResumedCount = Checkpoint.RemoveResolvedItems(WorkItems);
+	}
 
-		if (++AssetsSinceGC >= GCInterval)
+	if (bIncremental && !BatchOptions.bWriteTree)
+	{
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: -Incremental compares against the audit tree, which -NoTree doesn't update"));
+	}
+
+	int32 UpToDateCount = 0;
+	if (bIncremental)
+	{
+		UpToDateCount = FBlueprintAuditBatch::RemoveUpToDateItems(WorkItems);
+	}
+
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Auditing %d Blueprint(s)..."), WorkItems.Num());
+
+	FBlueprintAuditBatchResult Result;
+	if (NumWorkers > 0)
+	{
+		// Children recover from their own crashes; the parent journals (and bundles) each batch as it finishes
+		Result = FBlueprintAuditWorkers::RunOrchestrator(WorkItems, NumWorkers, WorkerBatchSize, BatchOptions, &Checkpoint);
+	}
+	else
+	{
+		Result = FBlueprintAuditBatch::Run(WorkItems, BatchOptions, nullptr, &Checkpoint);
+	}
+	Checkpoint.Finish();
+
+	// Quarantined packages are never loaded again by this run, but still have no valid audit
+	TArray<FString> FailedPackages = Result.FailedPackages;
+	FailedPackages.Append(Checkpoint.GetQuarantined());
+	FailedPackages.Sort();
+
+	// Incremental runs replace a full rebuild, so they also own orphan cleanup.
+	// An asset list only covers what it names, which was handled above.
+	if (bIncremental && !bFromAssetList)
+	{
+		SweptCount = FBlueprintAuditor::SweepOrphanedAuditFiles();
+	}
+
+	if (FBlueprintAuditBundle* Bundle = BatchOptions.Bundle.Get())
+	{
+		// Worker audits were packed per batch; this picks up resumed and up-to-date packages
+		FBlueprintAuditBatch::PackTreeIntoBundle(*Bundle, BundleItems, false);
+		if (!bFromAssetList)
 		{
-			CollectGarbage(RF_NoFlags);
-			AssetsSinceGC = 0;
+			TSet<FString> LivePackages;
+			for (const FBlueprintAuditWorkItem& Item : BundleItems)
+			{
+				LivePackages.Add(Item.PackageName);
+			}
+			Bundle->RemoveAllExcept(LivePackages);
 		}
+		Bundle->Commit();
+		UE_LOG(LogCoRider, Display, TEXT("CoRider: Bundle — %d appended, %d unchanged"),
+			Bundle->GetAppendedCount(), Bundle->GetUnchangedCount());
 	}
 
 	const double Elapsed = FPlatformTime::Seconds() - StartTime;
-	UE_LOG(LogCoRider, Display, TEXT("CoRider: Audit complete — %d written, %d skipped, %d failed in %.2fs"),
-		SuccessCount, SkipCount, FailCount, Elapsed);
+	const int32 SuccessCount = Result.WrittenCount;
+	const int32 FailCount = FailedPackages.Num();
+
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Audit complete — %d written (%d unchanged, write skipped), %d resumed, %d up-to-date, %d skipped, %d failed, %d orphan(s) swept, %d GC(s) (%.2fs) in %.2fs"),
+		SuccessCount, Result.UnchangedCount, ResumedCount, UpToDateCount, SkipCount, FailCount, SweptCount, Result.GCCount, Result.GCSeconds, Elapsed);
+
+	if (bSharded)
+	{
+		Shard.WriteManifest(AssignedPackages, FailedPackages, SuccessCount + ResumedCount, UpToDateCount, Elapsed);
+	}
 	return 0;
 }
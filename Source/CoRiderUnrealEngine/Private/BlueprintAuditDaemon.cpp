@@ -0,0 +1,435 @@
+#include "BlueprintAuditDaemon.h"
+
+#include "AssetRefHttpServer.h"
+#include "BlueprintAuditor.h"
+#include "BlueprintAuditBundle.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "HttpResultCallback.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+/** Finished jobs kept around for /audit/status. */
+static constexpr int32 MaxRetainedJobs = 100;
+
+/** How often HTTP is served while a job runs. */
+static constexpr double JobPumpInterval = 0.05;
+
+static void SendJson(const FHttpResultCallback& OnComplete, const TSharedRef<FJsonObject>& Json,
+	EHttpServerResponseCodes Code = EHttpServerResponseCodes::Ok)
+{
+	FString Body;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Body);
+	FJsonSerializer::Serialize(Json, Writer);
+
+	auto Response = FHttpServerResponse::Create(Body, TEXT("application/json"));
+	Response->Code = Code;
+	OnComplete(MoveTemp(Response));
+}
+
+static void SendError(const FHttpResultCallback& OnComplete, EHttpServerResponseCodes Code, const FString& Message)
+{
+	TSharedRef<FJsonObject> ErrorJson = MakeShared<FJsonObject>();
+	ErrorJson->SetStringField(TEXT("error"), Message);
+	SendJson(OnComplete, ErrorJson, Code);
+}
+
+FBlueprintAuditDaemon::FBlueprintAuditDaemon(const FBlueprintAuditBatchOptions& InOptions, double InIdleTimeoutSeconds)
+	: Options(InOptions)
+	, IdleTimeoutSeconds(InIdleTimeoutSeconds)
+	, HttpServer(MakeUnique<FAssetRefHttpServer>(TEXT(".corider-ue-audit-daemon.json")))
+{
+}
+
+FBlueprintAuditDaemon::~FBlueprintAuditDaemon()
+{
+	HttpServer->Stop();
+}
+
+int32 FBlueprintAuditDaemon::Run()
+{
+	RegisterRoutes();
+	if (!HttpServer->Start())
+	{
+		return 1;
+	}
+
+	StartedTime = LastActivityTime = LastPumpTime = LastTickTime = FPlatformTime::Seconds();
+
+	// The commandlet scanned the registry before handing over
+	LastScanTime = FDateTime::UtcNow();
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Audit daemon ready on port %d — exits after %.0fs idle"),
+		HttpServer->GetPort(), IdleTimeoutSeconds);
+
+	while (!bShutdownRequested && !IsEngineExitRequested())
+	{
+		PumpHttp(true);
+
+		if (PendingJobs.Num() > 0)
+		{
+			const TSharedRef<FJob> Job = PendingJobs[0];
+			PendingJobs.RemoveAt(0);
+			RunJob(*Job);
+			LastActivityTime = FPlatformTime::Seconds();
+			continue;
+		}
+
+		if (FPlatformTime::Seconds() - LastActivityTime >= IdleTimeoutSeconds)
+		{
+			UE_LOG(LogCoRider, Display, TEXT("CoRider: Audit daemon idle for %.0fs — shutting down"), IdleTimeoutSeconds);
+			break;
+		}
+
+		FPlatformProcess::Sleep(0.05f);
+	}
+
+	// Let the last responses (e.g. to /audit/shutdown) go out before the listener goes away
+	PumpHttp(true);
+	HttpServer->Stop();
+
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Audit daemon stopped after %d job(s) in %.0fs"),
+		NextJobId - 1, FPlatformTime::Seconds() - StartedTime);
+	return 0;
+}
+
+void FBlueprintAuditDaemon::RegisterRoutes()
+{
+	// GET /audit/health
+	HttpServer->AddRoute(FHttpPath(TEXT("/audit/health")), EHttpServerRequestVerbs::VERB_GET,
+		FHttpRequestHandler::CreateLambda([this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			LastActivityTime = FPlatformTime::Seconds();
+
+			TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+			ResponseJson->SetStringField(TEXT("status"), TEXT("ok"));
+			ResponseJson->SetNumberField(TEXT("port"), HttpServer->GetPort());
+			ResponseJson->SetNumberField(TEXT("pid"), FPlatformProcess::GetCurrentProcessId());
+			ResponseJson->SetNumberField(TEXT("uptimeSeconds"), FPlatformTime::Seconds() - StartedTime);
+			ResponseJson->SetNumberField(TEXT("pendingJobs"), PendingJobs.Num());
+			ResponseJson->SetNumberField(TEXT("idleTimeoutSeconds"), IdleTimeoutSeconds);
+			SendJson(OnComplete, ResponseJson);
+			return true;
+		}));
+
+	// POST /audit/jobs
+	HttpServer->AddRoute(FHttpPath(TEXT("/audit/jobs")), EHttpServerRequestVerbs::VERB_POST,
+		FHttpRequestHandler::CreateLambda([this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			LastActivityTime = FPlatformTime::Seconds();
+
+			const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+			const FString Body(Converted.Length(), Converted.Get());
+
+			TSharedPtr<FJsonObject> RequestJson;
+			if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Body), RequestJson) || !RequestJson.IsValid())
+			{
+				SendError(OnComplete, EHttpServerResponseCodes::BadRequest, TEXT("Body must be a JSON object"));
+				return true;
+			}
+
+			const TSharedRef<FJob> Job = MakeShared<FJob>();
+			RequestJson->TryGetBoolField(TEXT("stale"), Job->bStale);
+
+			const TArray<TSharedPtr<FJsonValue>>* Packages = nullptr;
+			if (!Job->bStale && RequestJson->TryGetArrayField(TEXT("packages"), Packages))
+			{
+				for (const TSharedPtr<FJsonValue>& Value : *Packages)
+				{
+					Job->Entries.Add(Value->AsString());
+				}
+			}
+
+			if (!Job->bStale && Job->Entries.IsEmpty())
+			{
+				SendError(OnComplete, EHttpServerResponseCodes::BadRequest,
+					TEXT("Expected {\"packages\": [\"/Game/Path/To/BP\", ...]} or {\"stale\": true}"));
+				return true;
+			}
+
+			Job->Id = NextJobId++;
+			Job->SubmitTime = FPlatformTime::Seconds();
+			Jobs.Add(Job);
+			PendingJobs.Add(Job);
+
+			if (Jobs.Num() > MaxRetainedJobs)
+			{
+				const int32 OldestDone = Jobs.IndexOfByPredicate([](const TSharedRef<FJob>& Existing)
+				{
+					return Existing->State == TEXT("done") || Existing->State == TEXT("cancelled");
+				});
+				if (OldestDone != INDEX_NONE)
+				{
+					Jobs.RemoveAt(OldestDone);
+				}
+			}
+
+			UE_LOG(LogCoRider, Display, TEXT("CoRider: Job %d queued — %s"), Job->Id,
+				Job->bStale ? TEXT("stale check") : *FString::Printf(TEXT("%d asset(s)"), Job->Entries.Num()));
+			SendJson(OnComplete, JobToJson(*Job).ToSharedRef(), EHttpServerResponseCodes::Accepted);
+			return true;
+		}));
+
+	// GET /audit/status
+	HttpServer->AddRoute(FHttpPath(TEXT("/audit/status")), EHttpServerRequestVerbs::VERB_GET,
+		FHttpRequestHandler::CreateLambda([this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			LastActivityTime = FPlatformTime::Seconds();
+
+			if (const FString* JobParam = Request.QueryParams.Find(TEXT("job")))
+			{
+				const int32 JobId = FCString::Atoi(**JobParam);
+				const TSharedRef<FJob>* Job = Jobs.FindByPredicate([JobId](const TSharedRef<FJob>& Existing)
+				{
+					return Existing->Id == JobId;
+				});
+				if (!Job)
+				{
+					SendError(OnComplete, EHttpServerResponseCodes::NotFound, FString::Printf(TEXT("No job %s"), **JobParam));
+					return true;
+				}
+				SendJson(OnComplete, JobToJson(**Job).ToSharedRef());
+				return true;
+			}
+
+			TArray<TSharedPtr<FJsonValue>> JobsArray;
+			for (const TSharedRef<FJob>& Job : Jobs)
+			{
+				JobsArray.Add(MakeShared<FJsonValueObject>(JobToJson(*Job)));
+			}
+
+			TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+			ResponseJson->SetArrayField(TEXT("jobs"), JobsArray);
+			SendJson(OnComplete, ResponseJson);
+			return true;
+		}));
+
+	// POST /audit/shutdown
+	HttpServer->AddRoute(FHttpPath(TEXT("/audit/shutdown")), EHttpServerRequestVerbs::VERB_POST,
+		FHttpRequestHandler::CreateLambda([this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+		{
+			// Finishes the running job; queued ones are reported as cancelled, not left queued forever
+			bShutdownRequested = true;
+			for (const TSharedRef<FJob>& Job : PendingJobs)
+			{
+				Job->State = TEXT("cancelled");
+				Job->FinishTime = FPlatformTime::Seconds();
+			}
+			PendingJobs.Empty();
+
+			TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+			ResponseJson->SetStringField(TEXT("status"), TEXT("shutting down"));
+			SendJson(OnComplete, ResponseJson);
+			return true;
+		}));
+}
+
+void FBlueprintAuditDaemon::RunJob(FJob& Job)
+{
+	Job.State = TEXT("running");
+	Job.StartTime = FPlatformTime::Seconds();
+	bJobRunning = true;
+
+	// Anything a previous job left loaded would hide changes made on disk since
+	CollectGarbage(RF_NoFlags);
+
+	TArray<FBlueprintAuditWorkItem> WorkItems;
+	TArray<FBlueprintAuditWorkItem> BundleItems;
+	if (Job.bStale)
+	{
+		// Pick up assets added, saved or deleted since the last scan, without re-reading every unchanged file
+		const TSet<FString> DeletedPackages(RescanChangedFiles());
+		for (const FString& PackageName : DeletedPackages)
+		{
+			const FString JsonPath = FBlueprintAuditor::GetAuditOutputPath(PackageName);
+			if (FPaths::FileExists(JsonPath) && FBlueprintAuditor::DeleteAuditJson(JsonPath))
+			{
+				++Job.Removed;
+			}
+		}
+
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		int32 SkipCount = 0;
+		for (const FAssetData& Asset : FBlueprintAuditBatch::GetProjectBlueprints(AssetRegistry, SkipCount))
+		{
+			if (!DeletedPackages.Contains(Asset.PackageName.ToString()))
+			{
+				WorkItems.Add(FBlueprintAuditBatch::MakeWorkItem(Asset));
+			}
+		}
+		Job.Total = WorkItems.Num();
+
+		// Deleted packages leave the bundle now; ones it has no record of yet are packed from the tree after the job
+		if (Options.Bundle)
+		{
+			TSet<FString> LivePackages;
+			for (const FBlueprintAuditWorkItem& Item : WorkItems)
+			{
+				LivePackages.Add(Item.PackageName);
+			}
+			Options.Bundle->RemoveAllExcept(LivePackages);
+			BundleItems = WorkItems;
+		}
+
+		Job.UpToDate = FBlueprintAuditBatch::RemoveUpToDateItems(WorkItems);
+		Job.Processed = Job.UpToDate;
+		Job.Removed += FBlueprintAuditor::SweepOrphanedAuditFiles();
+	}
+	else
+	{
+		TArray<FString> MissingPackages;
+		FBlueprintAuditBatch::ResolveAssetList(Job.Entries, WorkItems, MissingPackages, true);
+		for (const FString& PackageName : MissingPackages)
+		{
+			const FString JsonPath = FBlueprintAuditor::GetAuditOutputPath(PackageName);
+			if (FPaths::FileExists(JsonPath) && FBlueprintAuditor::DeleteAuditJson(JsonPath))
+			{
+				++Job.Removed;
+			}
+			if (Options.Bundle)
+			{
+				Options.Bundle->Remove(PackageName);
+			}
+		}
+		Job.Total = WorkItems.Num();
+	}
+	PumpHttp(true);
+
+	const FBlueprintAuditBatchResult Result = FBlueprintAuditBatch::Run(WorkItems, Options,
+		[this, &Job](const FBlueprintAuditWorkItem& Item, bool bAudited)
+		{
+			++Job.Processed;
+			PumpHttp(false);
+		});
+
+	Job.Written = Result.WrittenCount;
+	Job.Unchanged = Result.UnchangedCount;
+	Job.FailedPackages = Result.FailedPackages;
+
+	// Committed per job, so readers see each job's audits as soon as its status says done
+	if (Options.Bundle)
+	{
+		FBlueprintAuditBatch::PackTreeIntoBundle(*Options.Bundle, BundleItems, false);
+		Options.Bundle->Commit();
+	}
+	Job.FinishTime = FPlatformTime::Seconds();
+	Job.State = TEXT("done");
+	bJobRunning = false;
+
+	CollectGarbage(RF_NoFlags);
+
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Job %d done — %d written (%d unchanged), %d up-to-date, %d removed, %d failed in %.2fs"),
+		Job.Id, Job.Written, Job.Unchanged, Job.UpToDate, Job.Removed, Job.FailedPackages.Num(), Job.FinishTime - Job.StartTime);
+}
+
+void FBlueprintAuditDaemon::PumpHttp(bool bForce)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (!bForce && Now - LastPumpTime < JobPumpInterval)
+	{
+		return;
+	}
+
+	// Commandlets have no engine loop; the HTTP listeners are driven by the core ticker. The listener tick
+	// itself is private to the HTTP server module, so mid-job pumps pass no elapsed time: the listeners'
+	// zero-delay tickers still run, while interval tickers wait until the job is over.
+	if (bJobRunning)
+	{
+		FTSTicker::GetCoreTicker().Tick(0.0f);
+	}
+	else
+	{
+		FTSTicker::GetCoreTicker().Tick(static_cast<float>(Now - LastTickTime));
+		LastTickTime = Now;
+	}
+	LastPumpTime = Now;
+}
+
+TArray<FString> FBlueprintAuditDaemon::RescanChangedFiles()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	// Margin for coarse file times; a file saved during the walk is picked up now or by the next job
+	const FDateTime ScanStart = FDateTime::UtcNow();
+	const FDateTime ChangedSince = LastScanTime - FTimespan::FromSeconds(2.0);
+
+	// A stat walk is cheap next to a forced rescan, which re-reads every package header
+	TSet<FString> ExistingFiles;
+	TArray<FString> ChangedFiles;
+	const FString ContentDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir());
+	IFileManager::Get().IterateDirectoryStatRecursively(*ContentDir,
+		[&AssetRegistry, &ExistingFiles, &ChangedFiles, &ChangedSince](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+		{
+			const FString Filename(FilenameOrDirectory);
+			if (StatData.bIsDirectory || !Filename.EndsWith(FPackageName::GetAssetPackageExtension()))
+			{
+				return true;
+			}
+			ExistingFiles.Add(Filename);
+
+			// Also rescan files the registry has never seen: a move keeps the old modification time
+			FString PackageName;
+			if (StatData.ModificationTime >= ChangedSince
+				|| (FPackageName::TryConvertFilenameToLongPackageName(Filename, PackageName)
+					&& !AssetRegistry.GetAssetPackageDataCopy(FName(*PackageName)).IsSet()))
+			{
+				ChangedFiles.Add(Filename);
+			}
+			return true;
+		});
+
+	if (ChangedFiles.Num() > 0)
+	{
+		AssetRegistry.ScanFilesSynchronous(ChangedFiles, true);
+	}
+	LastScanTime = ScanStart;
+
+	// The registry keeps entries for files deleted since its last scan
+	TArray<FString> DeletedPackages;
+	int32 SkipCount = 0;
+	for (const FAssetData& Asset : FBlueprintAuditBatch::GetProjectBlueprints(AssetRegistry, SkipCount))
+	{
+		const FString PackageName = Asset.PackageName.ToString();
+		if (!ExistingFiles.Contains(FBlueprintAuditor::GetSourceFilePath(PackageName)))
+		{
+			DeletedPackages.Add(PackageName);
+		}
+	}
+
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Rescanned %d changed file(s) of %d, %d Blueprint(s) deleted"),
+		ChangedFiles.Num(), ExistingFiles.Num(), DeletedPackages.Num());
+	return DeletedPackages;
+}
+
+TSharedPtr<FJsonObject> FBlueprintAuditDaemon::JobToJson(const FJob& Job)
+{
+	TArray<TSharedPtr<FJsonValue>> FailedArray;
+	for (const FString& PackageName : Job.FailedPackages)
+	{
+		FailedArray.Add(MakeShared<FJsonValueString>(PackageName));
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	TSharedPtr<FJsonObject> JobJson = MakeShared<FJsonObject>();
+	JobJson->SetNumberField(TEXT("id"), Job.Id);
+	JobJson->SetStringField(TEXT("state"), Job.State);
+	JobJson->SetBoolField(TEXT("stale"), Job.bStale);
+	JobJson->SetNumberField(TEXT("total"), Job.Total);
+	JobJson->SetNumberField(TEXT("processed"), Job.Processed);
+	JobJson->SetNumberField(TEXT("written"), Job.Written);
+	JobJson->SetNumberField(TEXT("unchanged"), Job.Unchanged);
+	JobJson->SetNumberField(TEXT("upToDate"), Job.UpToDate);
+	JobJson->SetNumberField(TEXT("removed"), Job.Removed);
+	JobJson->SetArrayField(TEXT("failed"), FailedArray);
+	JobJson->SetNumberField(TEXT("queuedSeconds"), (Job.StartTime > 0.0 ? Job.StartTime : Now) - Job.SubmitTime);
+	JobJson->SetNumberField(TEXT("elapsedSeconds"),
+		Job.StartTime > 0.0 ? (Job.FinishTime > 0.0 ? Job.FinishTime : Now) - Job.StartTime : 0.0);
+	return JobJson;
+}
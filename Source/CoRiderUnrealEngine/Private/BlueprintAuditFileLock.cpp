@@ -0,0 +1,71 @@
+#include "BlueprintAuditFileLock.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Paths.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include "Windows/WindowsHWrapper.h"
+#include "Windows/HideWindowsPlatformTypes.h"
+#elif PLATFORM_UNIX || PLATFORM_MAC
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+FBlueprintAuditFileLock::FBlueprintAuditFileLock(const FString& InLockPath, double TimeoutSeconds)
+	: LockPath(FPaths::ConvertRelativePathToFull(InLockPath))
+{
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(LockPath), true);
+
+	const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+	while (!TryLock() && FPlatformTime::Seconds() < Deadline)
+	{
+		FPlatformProcess::Sleep(0.02f);
+	}
+}
+
+FBlueprintAuditFileLock::~FBlueprintAuditFileLock()
+{
+#if PLATFORM_WINDOWS
+	if (Handle)
+	{
+		CloseHandle(Handle);
+	}
+#elif PLATFORM_UNIX || PLATFORM_MAC
+	if (Descriptor >= 0)
+	{
+		// Closing the descriptor releases the flock
+		close(Descriptor);
+	}
+#endif
+}
+
+bool FBlueprintAuditFileLock::TryLock()
+{
+#if PLATFORM_WINDOWS
+	// No sharing: a second open fails until this handle is closed
+	const HANDLE LockHandle = CreateFileW(*LockPath, GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (LockHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	Handle = LockHandle;
+#elif PLATFORM_UNIX || PLATFORM_MAC
+	const int LockDescriptor = open(TCHAR_TO_UTF8(*LockPath), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+	if (LockDescriptor < 0)
+	{
+		return false;
+	}
+	if (flock(LockDescriptor, LOCK_EX | LOCK_NB) != 0)
+	{
+		close(LockDescriptor);
+		return false;
+	}
+	Descriptor = LockDescriptor;
+#endif
+	// Other platforms have no editor, so nothing else can contend for the file
+	bLocked = true;
+	return true;
+}
@@ -0,0 +1,79 @@
+#include "BlueprintAuditGCPolicy.h"
+
+#include "BlueprintAuditor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "UObject/UObjectGlobals.h"
+
+static TAutoConsoleVariable<int32> CVarAuditGCBudgetMB(
+	TEXT("CoRider.Audit.GCBudgetMB"),
+	0,
+	TEXT("Used physical memory (MB) above which Blueprint batch audits collect garbage. 0 = half of physical RAM."));
+
+static TAutoConsoleVariable<int32> CVarAuditGCMinInterval(
+	TEXT("CoRider.Audit.GCMinInterval"),
+	8,
+	TEXT("Minimum number of audited Blueprints between garbage collections."));
+
+int32 FBlueprintAuditGCPolicy::ResolveBudgetMB(int32 BudgetMB)
+{
+	if (BudgetMB <= 0)
+	{
+		BudgetMB = CVarAuditGCBudgetMB.GetValueOnAnyThread();
+	}
+	if (BudgetMB <= 0)
+	{
+		BudgetMB = static_cast<int32>(FPlatformMemory::GetStats().TotalPhysical / (2 * 1024 * 1024));
+	}
+	return BudgetMB;
+}
+
+FBlueprintAuditGCPolicy::FBlueprintAuditGCPolicy(int32 BudgetMB, int32 InMinAssetsBetween)
+	: BudgetBytes(static_cast<uint64>(ResolveBudgetMB(BudgetMB)) * 1024 * 1024)
+	, MinAssetsBetween(FMath::Max(InMinAssetsBetween > 0 ? InMinAssetsBetween : CVarAuditGCMinInterval.GetValueOnAnyThread(), 1))
+{
+}
+
+bool FBlueprintAuditGCPolicy::Tick()
+{
+	AddAsset();
+	return CollectIfDue();
+}
+
+bool FBlueprintAuditGCPolicy::CollectIfDue()
+{
+	// Memory stats aren't free on every platform, so don't even look until a GC would be allowed
+	if (AssetsSinceCollect < MinAssetsBetween)
+	{
+		return false;
+	}
+
+	const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	PeakUsedPhysical = FMath::Max(PeakUsedPhysical, UsedPhysical);
+	if (UsedPhysical < BudgetBytes)
+	{
+		return false;
+	}
+
+	const double CollectStart = FPlatformTime::Seconds();
+	CollectGarbage(RF_NoFlags);
+	CollectSeconds += FPlatformTime::Seconds() - CollectStart;
+	++CollectCount;
+	AssetsSinceCollect = 0;
+
+	// Still over budget means the baseline doesn't fit; we'll GC at the minimum interval from here on
+	const uint64 UsedAfter = FPlatformMemory::GetStats().UsedPhysical;
+	if (UsedAfter >= BudgetBytes && !bWarnedOverBudget)
+	{
+		bWarnedOverBudget = true;
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: %llu MB still in use after GC, over the %llu MB audit budget — raise CoRider.Audit.GCBudgetMB"),
+			UsedAfter / (1024 * 1024), BudgetBytes / (1024 * 1024));
+	}
+	return true;
+}
+
+void FBlueprintAuditGCPolicy::LogSummary() const
+{
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: GC — %d collection(s) in %.2fs, peak %llu MB used of %llu MB budget (min interval %d)"),
+		CollectCount, CollectSeconds, PeakUsedPhysical / (1024 * 1024), BudgetBytes / (1024 * 1024), MinAssetsBetween);
+}
@@ -0,0 +1,178 @@
+#include "BlueprintAuditHashCache.h"
+
+#include "BlueprintAuditor.h"
+#include "BlueprintAuditFileLock.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+static const TCHAR* ManifestHeader = TEXT("# CoRider source hashes: package, size, mtime ticks, algorithm, hash");
+
+FBlueprintAuditHashCache& FBlueprintAuditHashCache::Get()
+{
+	static FBlueprintAuditHashCache Instance;
+	return Instance;
+}
+
+FBlueprintAuditHashCache::FBlueprintAuditHashCache()
+{
+	LoadEntries(GetManifestPath(), Entries);
+}
+
+FString FBlueprintAuditHashCache::GetManifestPath()
+{
+	return FBlueprintAuditor::GetAuditVersionDir() / TEXT("SourceHashes.tsv");
+}
+
+void FBlueprintAuditHashCache::LoadEntries(const FString& Path, TMap<FString, FEntry>& OutEntries)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+	{
+		return;
+	}
+
+	TArray<FString> Fields;
+	for (const FString& Line : Lines)
+	{
+		if (Line.StartsWith(TEXT("#")))
+		{
+			continue;
+		}
+
+		// Manifests written before the algorithm column only ever held MD5 hashes
+		Line.ParseIntoArray(Fields, TEXT("\t"), false);
+		if (Fields.Num() != 4 && Fields.Num() != 5)
+		{
+			continue;
+		}
+
+		FEntry& Entry = OutEntries.Add(Fields[0]);
+		LexFromString(Entry.Size, *Fields[1]);
+		LexFromString(Entry.Timestamp, *Fields[2]);
+		Entry.Algorithm = Fields.Num() == 5 ? Fields[3] : TEXT("md5");
+		Entry.Hash = Fields.Last();
+	}
+}
+
+FString FBlueprintAuditHashCache::GetFileHash(const FString& PackageName, const FString& SourcePath)
+{
+	const FFileStatData Stat = IFileManager::Get().GetStatData(*SourcePath);
+	if (!Stat.bIsValid)
+	{
+		return FString();
+	}
+	const int64 Timestamp = Stat.ModificationTime.GetTicks();
+	const FString Algorithm = FBlueprintAuditor::GetSourceHashAlgorithm();
+
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (const FEntry* Entry = Entries.Find(PackageName))
+		{
+			if (Entry->Size == Stat.FileSize && Entry->Timestamp == Timestamp && Entry->Algorithm == Algorithm && !Entry->Hash.IsEmpty())
+			{
+				++Hits;
+				return Entry->Hash;
+			}
+		}
+	}
+
+	// Hash outside the lock so worker threads don't serialize on disk reads
+	const FString Hash = FBlueprintAuditor::ComputeFileHash(SourcePath);
+	if (Hash.IsEmpty())
+	{
+		return Hash;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	++Misses;
+	Entries.Add(PackageName, { Stat.FileSize, Timestamp, Algorithm, Hash });
+	Removed.Remove(PackageName);
+	bDirty = true;
+	++Generation;
+	return Hash;
+}
+
+void FBlueprintAuditHashCache::Remove(const FString& PackageName)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (Entries.Remove(PackageName) > 0)
+	{
+		Removed.Add(PackageName);
+		bDirty = true;
+		++Generation;
+	}
+}
+
+bool FBlueprintAuditHashCache::Save(double LockTimeoutSeconds)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (!bDirty)
+		{
+			return true;
+		}
+	}
+
+	// Read-merge-write under the file lock, or two processes saving at once would drop each other's entries.
+	// Taken before Lock, so threads hashing meanwhile never wait on another process.
+	const FString ManifestPath = GetManifestPath();
+	const FBlueprintAuditFileLock ManifestLock(ManifestPath + TEXT(".lock"), LockTimeoutSeconds);
+	if (!ManifestLock.IsLocked())
+	{
+		UE_LOG(LogCoRider, Log, TEXT("CoRider: Source hash manifest %s is locked by another process — saving later"), *ManifestPath);
+		return false;
+	}
+
+	TMap<FString, FEntry> OnDisk;
+	LoadEntries(ManifestPath, OnDisk);
+
+	// Lock covers only the in-memory merge; the file is written outside it
+	TStringBuilder<64 * 1024> Builder;
+	TSet<FString> SavedRemoved;
+	uint64 SavedGeneration = 0;
+	int32 EntryCount = 0;
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		// Keep what another process (editor, commandlet, worker) recorded since we loaded; our entries win
+		for (TPair<FString, FEntry>& Pair : OnDisk)
+		{
+			if (!Entries.Contains(Pair.Key) && !Removed.Contains(Pair.Key))
+			{
+				Entries.Add(Pair.Key, MoveTemp(Pair.Value));
+			}
+		}
+
+		Builder << ManifestHeader << TEXT('\n');
+		for (const TPair<FString, FEntry>& Pair : Entries)
+		{
+			Builder << Pair.Key << TEXT('\t') << Pair.Value.Size << TEXT('\t') << Pair.Value.Timestamp << TEXT('\t')
+				<< Pair.Value.Algorithm << TEXT('\t') << Pair.Value.Hash << TEXT('\n');
+		}
+		SavedRemoved = Removed;
+		SavedGeneration = Generation;
+		EntryCount = Entries.Num();
+	}
+
+	// Write beside the manifest, then rename over it so readers never see a partial file
+	const FString TempPath = FBlueprintAuditor::MakeTempFilePath(ManifestPath);
+	if (!FFileHelper::SaveStringToFile(Builder.ToView(), *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+		|| !FBlueprintAuditor::ReplaceFile(ManifestPath, TempPath))
+	{
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to save source hash manifest %s"), *ManifestPath);
+		IFileManager::Get().Delete(*TempPath, false, false, true);
+		return false;
+	}
+
+	// Whatever changed while the file was being written stays dirty for the next save
+	FScopeLock ScopeLock(&Lock);
+	UE_LOG(LogCoRider, Log, TEXT("CoRider: Source hash manifest saved — %d entries, %d reused, %d hashed since last save"),
+		EntryCount, Hits, Misses);
+	Removed = Removed.Difference(SavedRemoved);
+	bDirty = Generation != SavedGeneration;
+	Hits = 0;
+	Misses = 0;
+	return true;
+}
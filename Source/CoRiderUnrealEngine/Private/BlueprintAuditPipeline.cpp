@@ -0,0 +1,183 @@
+#include "BlueprintAuditPipeline.h"
+
+#include "BlueprintAuditor.h"
+#include "BlueprintAuditBundle.h"
+#include "BlueprintAuditHashCache.h"
+#include "BlueprintAuditStream.h"
+#include "Async/Async.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/QueuedThreadPool.h"
+#include "Serialization/MemoryWriter.h"
+
+FBlueprintAuditPipeline::FBlueprintAuditPipeline(int32 InNumThreads, int32 InMaxInFlight,
+	TSharedPtr<FBlueprintAuditStream> InStream, bool bInWriteFiles, TSharedPtr<FBlueprintAuditBundle> InBundle)
+	: NumThreads(FMath::Max(InNumThreads, 0))
+	, MaxInFlight(FMath::Max(InMaxInFlight, 1))
+	, Stream(MoveTemp(InStream))
+	, bWriteFiles(bInWriteFiles)
+	, Bundle(MoveTemp(InBundle))
+{
+	if (NumThreads > 0)
+	{
+		ThreadPool = FQueuedThreadPool::Allocate();
+		ThreadPool->Create(NumThreads, 128 * 1024, TPri_Normal, TEXT("CoRiderAuditPool"));
+		SlotFreedEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	}
+}
+
+FBlueprintAuditPipeline::~FBlueprintAuditPipeline()
+{
+	Flush();
+
+	if (ThreadPool)
+	{
+		ThreadPool->Destroy();
+		delete ThreadPool;
+		ThreadPool = nullptr;
+	}
+
+	if (SlotFreedEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(SlotFreedEvent);
+		SlotFreedEvent = nullptr;
+	}
+}
+
+void FBlueprintAuditPipeline::Enqueue(FBlueprintAuditWriteJob&& Job)
+{
+	if (!ThreadPool)
+	{
+		ProcessJob(Job);
+		return;
+	}
+
+	// Backpressure: wait for a free slot so finished audits can't pile up in memory
+	if (InFlight.load() >= MaxInFlight)
+	{
+		const double StallStart = FPlatformTime::Seconds();
+		while (InFlight.load() >= MaxInFlight)
+		{
+			// Timed wait so a trigger that lands between the check and the wait is never lost
+			SlotFreedEvent->Wait(10);
+		}
+		StallSeconds += FPlatformTime::Seconds() - StallStart;
+	}
+
+	++InFlight;
+	AsyncPool(*ThreadPool, [this, Job = MoveTemp(Job)]() mutable
+	{
+		ProcessJob(Job);
+		--InFlight;
+		SlotFreedEvent->Trigger();
+	});
+}
+
+void FBlueprintAuditPipeline::Flush()
+{
+	while (InFlight.load() > 0)
+	{
+		SlotFreedEvent->Wait(10);
+	}
+}
+
+void FBlueprintAuditPipeline::ProcessJob(FBlueprintAuditWriteJob& Job)
+{
+	// --- Hash ---
+	if (!Job.SourceFileHash.IsEmpty())
+	{
+		Job.Audit.SourceFileHash = Job.SourceFileHash;
+	}
+	else if (!Job.SourcePath.IsEmpty())
+	{
+		const uint64 HashStart = FPlatformTime::Cycles64();
+		Job.Audit.SourceFileHash = FBlueprintAuditHashCache::Get().GetFileHash(Job.PackageName, Job.SourcePath);
+		HashCycles += FPlatformTime::Cycles64() - HashStart;
+		++HashedCount;
+	}
+
+	// --- Serialize (NDJSON record / bundle record) ---
+	TArray<uint8> Record;
+	if (Stream || Bundle)
+	{
+		const uint64 SerializeStart = FPlatformTime::Cycles64();
+		FMemoryWriter RecordWriter(Record);
+		FBlueprintAuditor::SerializeAuditJson(Job.Audit, RecordWriter);
+		SerializeCycles += FPlatformTime::Cycles64() - SerializeStart;
+		SerializedBytes += Record.Num();
+	}
+
+	// --- Write ---
+	// The tree file is serialized straight into the file archive, so this stage includes its serialization
+	const uint64 WriteStart = FPlatformTime::Cycles64();
+	if (Bundle)
+	{
+		Bundle->Put(Job.PackageName, Record);
+	}
+	int64 FileBytes = 0;
+	bool bUnchanged = false;
+	const bool bWritten = !bWriteFiles || FBlueprintAuditor::WriteAuditJson(Job.Audit, Job.OutputPath, &FileBytes, &bUnchanged);
+
+	// A record is only streamed once its audit is on disk, so a consumer never sees one the tree doesn't have
+	if (Stream && bWritten)
+	{
+		Stream->WriteRecord(Job.PackageName, reinterpret_cast<const ANSICHAR*>(Record.GetData()), Record.Num());
+	}
+	WriteCycles += FPlatformTime::Cycles64() - WriteStart;
+	WrittenBytes += FileBytes;
+	if (bUnchanged)
+	{
+		++UnchangedCount;
+	}
+
+	if (bWritten)
+	{
+		++WrittenCount;
+	}
+	else
+	{
+		++FailedCount;
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to write audit for %s"), *Job.PackageName);
+
+		FScopeLock Lock(&FailedPackagesLock);
+		FailedPackages.Add(Job.PackageName);
+	}
+}
+
+TArray<FString> FBlueprintAuditPipeline::GetFailedPackages() const
+{
+	FScopeLock Lock(&FailedPackagesLock);
+	return FailedPackages;
+}
+
+void FBlueprintAuditPipeline::LogSummary() const
+{
+	auto Rate = [](int32 Count, double Seconds)
+	{
+		return Seconds > 0.0 ? Count / Seconds : 0.0;
+	};
+
+	const double HashSeconds = FPlatformTime::ToSeconds64(HashCycles.load());
+	const double SerializeSeconds = FPlatformTime::ToSeconds64(SerializeCycles.load());
+	const double WriteSeconds = FPlatformTime::ToSeconds64(WriteCycles.load());
+	const int32 Processed = WrittenCount.load() + FailedCount.load();
+
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Pipeline (%d thread(s), queue depth %d) — stage times summed across threads:"),
+		NumThreads, ThreadPool ? MaxInFlight : 0);
+	UE_LOG(LogCoRider, Display, TEXT("CoRider:   hash      %6d in %7.2fs (%.1f/s)"),
+		HashedCount.load(), HashSeconds, Rate(HashedCount.load(), HashSeconds));
+	if (Stream || Bundle)
+	{
+		UE_LOG(LogCoRider, Display, TEXT("CoRider:   serialize %6d in %7.2fs (%.1f/s, %.1f MB of compact JSON)"),
+			Processed, SerializeSeconds, Rate(Processed, SerializeSeconds), SerializedBytes.load() / (1024.0 * 1024.0));
+	}
+	UE_LOG(LogCoRider, Display, TEXT("CoRider:   write     %6d in %7.2fs (%.1f/s, %.1f MB of %s JSON%s, %d unchanged and skipped)"),
+		Processed, WriteSeconds, Rate(Processed, WriteSeconds), WrittenBytes.load() / (1024.0 * 1024.0),
+		FBlueprintAuditor::IsPrettyJson() ? TEXT("pretty") : TEXT("compact"),
+		FBlueprintAuditor::IsCompactBinaryEnabled() ? TEXT(" and Compact Binary") : TEXT(""), UnchangedCount.load());
+	if (ThreadPool)
+	{
+		UE_LOG(LogCoRider, Display, TEXT("CoRider:   game thread stalled %.2fs on a full queue"), StallSeconds);
+	}
+}
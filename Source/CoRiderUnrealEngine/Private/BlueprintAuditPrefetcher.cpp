@@ -0,0 +1,128 @@
+#include "BlueprintAuditPrefetcher.h"
+
+#include "BlueprintAuditor.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+
+FBlueprintAuditPrefetcher::FBlueprintAuditPrefetcher(TArray<FName> InPackageNames, TArray<int64> InPackageSizes, int32 InMaxDepth, int64 InBudgetBytes)
+	: PackageNames(MoveTemp(InPackageNames))
+	, PackageSizes(MoveTemp(InPackageSizes))
+	, MaxDepth(FMath::Max(InMaxDepth, 1))
+	, BudgetBytes(InBudgetBytes)
+{
+	check(PackageNames.Num() == PackageSizes.Num());
+	Refill();
+}
+
+FBlueprintAuditPrefetcher::~FBlueprintAuditPrefetcher()
+{
+	// Completion callbacks capture this; make sure none can fire after we're gone
+	for (const TPair<int32, FSlot>& Pair : Window)
+	{
+		if (!Pair.Value.bDone && Pair.Value.RequestId != INDEX_NONE)
+		{
+			FlushAsyncLoading(Pair.Value.RequestId);
+		}
+	}
+	Window.Empty();
+}
+
+UPackage* FBlueprintAuditPrefetcher::Wait(int32 Index)
+{
+	if (!Window.Contains(Index))
+	{
+		// Not yet requested (window was full, or the caller skipped ahead) — request it now
+		NextToIssue = FMath::Max(NextToIssue, Index + 1);
+		Issue(Index);
+	}
+
+	FSlot* Slot = Window.Find(Index);
+	if (Slot->bDone)
+	{
+		++ReadyHits;
+	}
+	else
+	{
+		const double WaitStart = FPlatformTime::Seconds();
+		FlushAsyncLoading(Slot->RequestId);
+		WaitSeconds += FPlatformTime::Seconds() - WaitStart;
+
+		// Flushing fires the completion callback, but the map may have been touched meanwhile
+		Slot = Window.Find(Index);
+		Slot->bDone = true;
+	}
+
+	return Slot->Package.Get();
+}
+
+void FBlueprintAuditPrefetcher::Release(int32 Index)
+{
+	if (const FSlot* Slot = Window.Find(Index))
+	{
+		WindowBytes -= Slot->Bytes;
+		Window.Remove(Index);
+	}
+	Refill();
+}
+
+void FBlueprintAuditPrefetcher::Pump(double TimeLimitSeconds)
+{
+	if (IsAsyncLoading())
+	{
+		ProcessAsyncLoading(true, false, TimeLimitSeconds);
+	}
+}
+
+void FBlueprintAuditPrefetcher::Refill()
+{
+	while (NextToIssue < PackageNames.Num() && Window.Num() < MaxDepth)
+	{
+		// Always keep at least one request going, even if a single package exceeds the budget
+		if (Window.Num() > 0 && WindowBytes + PackageSizes[NextToIssue] > BudgetBytes)
+		{
+			break;
+		}
+		Issue(NextToIssue++);
+	}
+}
+
+void FBlueprintAuditPrefetcher::Issue(int32 Index)
+{
+	FSlot& Slot = Window.Add(Index);
+	Slot.Bytes = PackageSizes[Index];
+	WindowBytes += Slot.Bytes;
+
+	// The callback runs on the game thread while async loading is processed (Pump/Wait).
+	// Look the slot up by index: the map may have rehashed since the request was issued.
+	const int32 RequestId = LoadPackageAsync(PackageNames[Index].ToString(),
+		FLoadPackageAsyncDelegate::CreateLambda([this, Index](const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+		{
+			if (FSlot* Pending = Window.Find(Index))
+			{
+				Pending->bDone = true;
+				if (Result == EAsyncLoadingResult::Succeeded && LoadedPackage)
+				{
+					Pending->Package.Reset(LoadedPackage);
+					ForEachObjectWithPackage(LoadedPackage, [Pending](UObject* Object)
+					{
+						if (Object->IsAsset())
+						{
+							Pending->Assets.Emplace(Object);
+						}
+						return true;
+					}, false);
+				}
+				else
+				{
+					UE_LOG(LogCoRider, Warning, TEXT("CoRider: Async load failed for %s"), *PackageName.ToString());
+				}
+			}
+		}));
+
+	// LoadPackageAsync can complete synchronously and fire the callback before returning
+	if (FSlot* Issued = Window.Find(Index))
+	{
+		Issued->RequestId = RequestId;
+	}
+}
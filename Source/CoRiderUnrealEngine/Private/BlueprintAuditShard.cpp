@@ -0,0 +1,214 @@
+#include "BlueprintAuditShard.h"
+
+#include "BlueprintAuditor.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+static TArray<TSharedPtr<FJsonValue>> ToJsonStringArray(const TArray<FString>& Strings)
+{
+	TArray<TSharedPtr<FJsonValue>> Values;
+	Values.Reserve(Strings.Num());
+	for (const FString& String : Strings)
+	{
+		Values.Add(MakeShareable(new FJsonValueString(String)));
+	}
+	return Values;
+}
+
+bool FBlueprintAuditShard::Parse(const FString& Spec, FBlueprintAuditShard& OutShard)
+{
+	FString IndexStr;
+	FString CountStr;
+	if (!Spec.Split(TEXT("/"), &IndexStr, &CountStr) || !IndexStr.IsNumeric() || !CountStr.IsNumeric())
+	{
+		return false;
+	}
+
+	const int32 ParsedIndex = FCString::Atoi(*IndexStr);
+	const int32 ParsedCount = FCString::Atoi(*CountStr);
+	if (ParsedCount < 1 || ParsedIndex < 0 || ParsedIndex >= ParsedCount)
+	{
+		return false;
+	}
+
+	OutShard.Index = ParsedIndex;
+	OutShard.Count = ParsedCount;
+	return true;
+}
+
+bool FBlueprintAuditShard::Contains(const FString& PackageName) const
+{
+	// StrCrc32 hashes every character as 32 bits, so the result doesn't depend on TCHAR width
+	return FCrc::StrCrc32(*PackageName.ToLower()) % static_cast<uint32>(Count) == static_cast<uint32>(Index);
+}
+
+FString FBlueprintAuditShard::GetManifestDir()
+{
+	return FBlueprintAuditor::GetAuditVersionDir() / TEXT("Shards");
+}
+
+FString FBlueprintAuditShard::GetManifestPath() const
+{
+	return GetManifestDir() / FString::Printf(TEXT("shard-%d-of-%d.json"), Index, Count);
+}
+
+void FBlueprintAuditShard::DeleteManifest() const
+{
+	IFileManager::Get().Delete(*GetManifestPath(), false, false, true);
+}
+
+bool FBlueprintAuditShard::WriteManifest(const TArray<FString>& AssignedPackages, const TArray<FString>& FailedPackages,
+	int32 WrittenCount, int32 UpToDateCount, double ElapsedSeconds) const
+{
+	TSharedPtr<FJsonObject> Manifest = MakeShareable(new FJsonObject());
+	Manifest->SetNumberField(TEXT("Shard"), Index);
+	Manifest->SetNumberField(TEXT("ShardCount"), Count);
+	Manifest->SetNumberField(TEXT("SchemaVersion"), FBlueprintAuditor::AuditSchemaVersion);
+	Manifest->SetStringField(TEXT("Completed"), FDateTime::UtcNow().ToIso8601());
+	Manifest->SetNumberField(TEXT("ElapsedSeconds"), ElapsedSeconds);
+	Manifest->SetNumberField(TEXT("Written"), WrittenCount);
+	Manifest->SetNumberField(TEXT("UpToDate"), UpToDateCount);
+	Manifest->SetArrayField(TEXT("Assigned"), ToJsonStringArray(AssignedPackages));
+	Manifest->SetArrayField(TEXT("Failed"), ToJsonStringArray(FailedPackages));
+
+	const FString ManifestPath = GetManifestPath();
+	if (!FBlueprintAuditor::WriteAuditJson(Manifest, ManifestPath))
+	{
+		return false;
+	}
+
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Shard %d/%d manifest written to %s"), Index, Count, *ManifestPath);
+	return true;
+}
+
+int32 FBlueprintAuditShard::MergeManifests(const TArray<FString>& ExpectedPackages, int32 ShardCount)
+{
+	const FString ManifestDir = GetManifestDir();
+
+	TArray<FString> ManifestFiles;
+	IFileManager::Get().FindFiles(ManifestFiles, *(ManifestDir / TEXT("shard-*-of-*.json")), true, false);
+
+	// Parse every manifest up front; a shard count can only be inferred once we've seen them all
+	TArray<TSharedPtr<FJsonObject>> Manifests;
+	TSet<int32> SeenCounts;
+	for (const FString& FileName : ManifestFiles)
+	{
+		FString JsonString;
+		TSharedPtr<FJsonObject> Manifest;
+		if (!FFileHelper::LoadFileToString(JsonString, *(ManifestDir / FileName))
+			|| !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonString), Manifest)
+			|| !Manifest.IsValid())
+		{
+			UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to parse shard manifest %s"), *FileName);
+			continue;
+		}
+
+		if (Manifest->GetIntegerField(TEXT("SchemaVersion")) != FBlueprintAuditor::AuditSchemaVersion)
+		{
+			continue;
+		}
+
+		SeenCounts.Add(Manifest->GetIntegerField(TEXT("ShardCount")));
+		Manifests.Add(Manifest);
+	}
+
+	if (ShardCount <= 0)
+	{
+		if (SeenCounts.Num() != 1)
+		{
+			UE_LOG(LogCoRider, Error, TEXT("CoRider: Found manifests for %d different shard counts in %s — pass -MergeShards=N"),
+				SeenCounts.Num(), *ManifestDir);
+			return 1;
+		}
+		ShardCount = *SeenCounts.CreateConstIterator();
+	}
+
+	TSet<int32> PresentShards;
+	TMap<FString, int32> CoveredBy;
+	TSet<FString> Failed;
+	int32 DuplicateCount = 0;
+
+	for (const TSharedPtr<FJsonObject>& Manifest : Manifests)
+	{
+		if (Manifest->GetIntegerField(TEXT("ShardCount")) != ShardCount)
+		{
+			continue;
+		}
+
+		const int32 ShardIndex = Manifest->GetIntegerField(TEXT("Shard"));
+		PresentShards.Add(ShardIndex);
+
+		for (const TSharedPtr<FJsonValue>& Value : Manifest->GetArrayField(TEXT("Assigned")))
+		{
+			const FString PackageName = Value->AsString();
+			if (CoveredBy.Contains(PackageName))
+			{
+				++DuplicateCount;
+				continue;
+			}
+			CoveredBy.Add(PackageName, ShardIndex);
+		}
+
+		for (const TSharedPtr<FJsonValue>& Value : Manifest->GetArrayField(TEXT("Failed")))
+		{
+			Failed.Add(Value->AsString());
+		}
+	}
+
+	TArray<FString> MissingShards;
+	for (int32 ShardIndex = 0; ShardIndex < ShardCount; ++ShardIndex)
+	{
+		if (!PresentShards.Contains(ShardIndex))
+		{
+			MissingShards.Add(FString::FromInt(ShardIndex));
+		}
+	}
+
+	TArray<FString> Uncovered;
+	for (const FString& PackageName : ExpectedPackages)
+	{
+		if (!CoveredBy.Contains(PackageName))
+		{
+			Uncovered.Add(PackageName);
+		}
+	}
+
+	TArray<FString> FailedSorted = Failed.Array();
+	FailedSorted.Sort();
+
+	const bool bComplete = MissingShards.IsEmpty() && Uncovered.IsEmpty() && FailedSorted.IsEmpty();
+
+	TSharedPtr<FJsonObject> Report = MakeShareable(new FJsonObject());
+	Report->SetNumberField(TEXT("ShardCount"), ShardCount);
+	Report->SetNumberField(TEXT("SchemaVersion"), FBlueprintAuditor::AuditSchemaVersion);
+	Report->SetStringField(TEXT("Merged"), FDateTime::UtcNow().ToIso8601());
+	Report->SetBoolField(TEXT("Complete"), bComplete);
+	Report->SetNumberField(TEXT("Expected"), ExpectedPackages.Num());
+	Report->SetNumberField(TEXT("Covered"), CoveredBy.Num());
+	Report->SetNumberField(TEXT("Duplicates"), DuplicateCount);
+	Report->SetArrayField(TEXT("MissingShards"), ToJsonStringArray(MissingShards));
+	Report->SetArrayField(TEXT("Uncovered"), ToJsonStringArray(Uncovered));
+	Report->SetArrayField(TEXT("Failed"), ToJsonStringArray(FailedSorted));
+
+	const FString ReportPath = ManifestDir / TEXT("merge-report.json");
+	FBlueprintAuditor::WriteAuditJson(Report, ReportPath);
+
+	for (const FString& PackageName : Uncovered)
+	{
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: Not covered by any shard: %s"), *PackageName);
+	}
+
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Shard merge %s — %d/%d shard(s), %d of %d Blueprint(s) covered, %d uncovered, %d failed, %d duplicate(s). Report: %s"),
+		bComplete ? TEXT("complete") : TEXT("INCOMPLETE"),
+		PresentShards.Num(), ShardCount, ExpectedPackages.Num() - Uncovered.Num(), ExpectedPackages.Num(),
+		Uncovered.Num(), FailedSorted.Num(), DuplicateCount, *ReportPath);
+
+	return bComplete ? 0 : 1;
+}
@@ -0,0 +1,67 @@
+#include "BlueprintAuditStream.h"
+
+#include "BlueprintAuditor.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+#include <cstdio>
+
+TSharedPtr<FBlueprintAuditStream> FBlueprintAuditStream::Open(const FString& Path, bool bKeyed)
+{
+	TSharedPtr<FBlueprintAuditStream> Stream = MakeShareable(new FBlueprintAuditStream());
+	Stream->bKeyed = bKeyed;
+	if (Path == TEXT("-"))
+	{
+		return Stream;
+	}
+
+	const FString FilePath = Path.IsEmpty() ? GetDefaultPath() : Path;
+	Stream->FileWriter.Reset(IFileManager::Get().CreateFileWriter(*FilePath, FILEWRITE_AllowRead));
+	if (!Stream->FileWriter)
+	{
+		UE_LOG(LogCoRider, Error, TEXT("CoRider: Failed to open stream output %s"), *FilePath);
+		return nullptr;
+	}
+	if (!bKeyed)
+	{
+		UE_LOG(LogCoRider, Display, TEXT("CoRider: Streaming audit records to %s"), *FPaths::ConvertRelativePathToFull(FilePath));
+	}
+	return Stream;
+}
+
+FString FBlueprintAuditStream::GetDefaultPath()
+{
+	return FBlueprintAuditor::GetAuditVersionDir() / TEXT("Stream.ndjson");
+}
+
+void FBlueprintAuditStream::WriteRecord(const FString& PackageName, const ANSICHAR* Json, int64 Length)
+{
+	// One buffer per record, so concurrent writers and a reader polling the file never see it split
+	TArray<ANSICHAR> Line;
+	Line.Reserve(Length + PackageName.Len() + 3);
+	if (bKeyed)
+	{
+		const FTCHARToUTF8 Key(*PackageName);
+		Line.Append(Key.Get(), Key.Length());
+		Line.Add('\t');
+	}
+	else if (!FileWriter)
+	{
+		Line.Add(RecordSeparator);
+	}
+	Line.Append(Json, Length);
+	Line.Add('\n');
+
+	FScopeLock ScopeLock(&Lock);
+	if (FileWriter)
+	{
+		FileWriter->Serialize(Line.GetData(), Line.Num());
+		FileWriter->Flush();
+	}
+	else
+	{
+		fwrite(Line.GetData(), 1, static_cast<size_t>(Line.Num()), stdout);
+		fflush(stdout);
+	}
+}
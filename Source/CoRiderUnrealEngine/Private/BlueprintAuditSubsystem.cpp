@@ -1,15 +1,68 @@
 #include "BlueprintAuditSubsystem.h"
 
 #include "BlueprintAuditor.h"
+#include "BlueprintAuditBatch.h"
+#include "BlueprintAuditBundle.h"
+#include "BlueprintAuditGCPolicy.h"
+#include "BlueprintAuditHashCache.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "DirectoryWatcherModule.h"
 #include "Dom/JsonObject.h"
 #include "Engine/Blueprint.h"
-#include "HAL/FileManager.h"
-#include "Misc/FileHelper.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "HAL/IConsoleManager.h"
+#include "IDirectoryWatcher.h"
 #include "Misc/PackageName.h"
-#include "Serialization/JsonSerializer.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+#include "Subsystems/AssetEditorSubsystem.h"
 #include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
 #include "UObject/UObjectIterator.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+#define LOCTEXT_NAMESPACE "CoRiderBlueprintAudit"
+
+/** Delay before a requested hash manifest save, so a run of saves, deletes or renames rewrites it once. */
+static constexpr double HashCacheSaveDelaySeconds = 10.0;
+
+static TAutoConsoleVariable<float> CVarAuditBackgroundBudgetMs(
+	TEXT("CoRider.Audit.BackgroundBudgetMs"),
+	5.0f,
+	TEXT("Game-thread milliseconds per tick that background Blueprint audits may use."));
+
+static TAutoConsoleVariable<float> CVarAuditBackgroundIdleSeconds(
+	TEXT("CoRider.Audit.BackgroundIdleSeconds"),
+	0.5f,
+	TEXT("Background Blueprint audits pause until the user has been idle for this many seconds."));
+
+static TAutoConsoleVariable<int32> CVarAuditBackgroundLoads(
+	TEXT("CoRider.Audit.BackgroundLoads"),
+	4,
+	TEXT("Packages the editor's background audits keep loading asynchronously at once."));
+
+static TAutoConsoleVariable<float> CVarAuditWatchCoalesceSeconds(
+	TEXT("CoRider.Audit.WatchCoalesceSeconds"),
+	2.0f,
+	TEXT("Quiet period after the last .uasset change on disk before the changed Blueprints are checked (coalesces VCS syncs)."));
+
+static TAutoConsoleVariable<int32> CVarAuditSectionCacheSize(
+	TEXT("CoRider.Audit.SectionCacheSize"),
+	32,
+	TEXT("Recently saved Blueprints whose audit sections are kept for incremental re-audits on save."));
+
+static TAutoConsoleVariable<bool> CVarAuditBundle(
+	TEXT("CoRider.Audit.Bundle"),
+	false,
+	TEXT("Also keep audits refreshed by the editor in the packed bundle, Saved/Audit/v<N>/Blueprints.bundle."));
+
+static TAutoConsoleVariable<bool> CVarAuditBundleCompress(
+	TEXT("CoRider.Audit.BundleCompress"),
+	false,
+	TEXT("Zlib-compress records the editor appends to the audit bundle."));
 
 void UBlueprintAuditSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -21,23 +74,85 @@ void UBlueprintAuditSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	AssetRegistry.OnAssetRemoved().AddUObject(this, &UBlueprintAuditSubsystem::OnAssetRemoved);
 	AssetRegistry.OnAssetRenamed().AddUObject(this, &UBlueprintAuditSubsystem::OnAssetRenamed);
 
-	// Schedule a deferred stale-check for after the asset registry finishes loading
-	StaleCheckTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
-		FTickerDelegate::CreateUObject(this, &UBlueprintAuditSubsystem::OnStaleCheckTick));
+	// Commandlets (including -Daemon, which pumps the core ticker) run their own stale checks
+	if (!IsRunningCommandlet())
+	{
+		// Open Blueprints jump the background queue
+		AssetEditorSubsystem = Collection.InitializeDependency<UAssetEditorSubsystem>();
+		if (AssetEditorSubsystem.IsValid())
+		{
+			AssetEditorSubsystem->OnAssetOpenedInEditor().AddUObject(this, &UBlueprintAuditSubsystem::OnAssetOpenedInEditor);
+		}
+
+		// Starts the stale check once the asset registry finishes loading, then drains background audits
+		BackgroundTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UBlueprintAuditSubsystem::OnBackgroundTick));
+
+		// Catch .uasset changes made outside the editor (VCS sync, another tool)
+		WatchedContentDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir());
+		FDirectoryWatcherModule& DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>("DirectoryWatcher");
+		if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get())
+		{
+			DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(WatchedContentDir,
+				IDirectoryWatcher::FDirectoryChanged::CreateUObject(this, &UBlueprintAuditSubsystem::OnContentDirectoryChanged),
+				DirectoryWatcherHandle);
+		}
+	}
 
 	UE_LOG(LogCoRider, Display, TEXT("CoRider: Subsystem initialized, watching for Blueprint saves."));
 }
 
 void UBlueprintAuditSubsystem::Deinitialize()
 {
-	if (StaleCheckTickerHandle.IsValid())
+	if (BackgroundTickerHandle.IsValid())
 	{
-		FTSTicker::GetCoreTicker().RemoveTicker(StaleCheckTickerHandle);
-		StaleCheckTickerHandle.Reset();
+		FTSTicker::GetCoreTicker().RemoveTicker(BackgroundTickerHandle);
+		BackgroundTickerHandle.Reset();
+	}
+
+	if (DirectoryWatcherHandle.IsValid())
+	{
+		if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>("DirectoryWatcher"))
+		{
+			if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+			{
+				DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(WatchedContentDir, DirectoryWatcherHandle);
+			}
+		}
+		DirectoryWatcherHandle.Reset();
+	}
+
+	// Neither the check task nor a load callback may outlive us
+	if (CheckFuture.IsValid())
+	{
+		CheckFuture.Wait();
+	}
+	for (const FBackgroundLoad& Load : Loads)
+	{
+		if (!Load.bDone && Load.RequestId != INDEX_NONE)
+		{
+			FlushAsyncLoading(Load.RequestId);
+		}
+	}
+	Loads.Reset();
+	PendingAudits.Reset();
+	PendingPackages.Reset();
+	CommitBundle();
+	FBlueprintAuditHashCache::Get().Save();
+	if (ProgressNotification.IsValid())
+	{
+		ProgressNotification->ExpireAndFadeout();
+		ProgressNotification.Reset();
 	}
 
 	UPackage::PackageSavedWithContextEvent.RemoveAll(this);
 
+	if (AssetEditorSubsystem.IsValid())
+	{
+		AssetEditorSubsystem->OnAssetOpenedInEditor().RemoveAll(this);
+		AssetEditorSubsystem.Reset();
+	}
+
 	if (FModuleManager::Get().IsModuleLoaded("AssetRegistry"))
 	{
 		IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
@@ -69,18 +184,111 @@ void UBlueprintAuditSubsystem::OnPackageSaved(const FString& PackageFileName, UP
 		return;
 	}
 
+	// Audited right here, so a queued background re-audit would be redundant
+	const FString SavedPackageName = Package->GetName();
+	if (PendingPackages.Remove(SavedPackageName) > 0)
+	{
+		PendingAudits.RemoveAll([&SavedPackageName](const FPendingAudit& Pending) { return Pending.Item.PackageName == SavedPackageName; });
+		PendingAudits.Heapify();
+	}
+
 	// Walk all objects in the saved package, looking for Blueprints
-	ForEachObjectWithPackage(Package, [](UObject* Object)
+	ForEachObjectWithPackage(Package, [this](UObject* Object)
 	{
 		if (const UBlueprint* BP = Cast<UBlueprint>(Object))
 		{
-			UE_LOG(LogCoRider, Verbose, TEXT("CoRider: Auditing saved Blueprint %s"), *BP->GetName());
+			FBlueprintAuditor::FSectionCache& SectionCache = FindOrAddSectionCache(BP->GetPathName());
 			const FString OutputPath = FBlueprintAuditor::GetAuditOutputPath(BP);
-			const TSharedPtr<FJsonObject> AuditJson = FBlueprintAuditor::AuditBlueprint(BP);
-			FBlueprintAuditor::WriteAuditJson(AuditJson, OutputPath);
+			const FBlueprintAuditData Audit = FBlueprintAuditor::AuditBlueprint(BP, true, FString(), &SectionCache);
+			FBlueprintAuditor::WriteAuditJson(Audit, OutputPath);
+			PutInBundle(BP->GetPackage()->GetName(), Audit);
+			NoteAudited(BP->GetPackage()->GetName());
+			UE_LOG(LogCoRider, Verbose, TEXT("CoRider: Audited saved Blueprint %s — %d section(s) reused, %d recomputed"),
+				*BP->GetName(), SectionCache.ReusedCount, SectionCache.RecomputedCount);
 		}
 		return true; // continue iteration
 	});
+
+	// The save changed the file's size/timestamp, so the audit above just refreshed its manifest entry
+	RequestHashCacheSave();
+
+	// A running background burst commits once it drains
+	if (BurstTotal == 0)
+	{
+		CommitBundle();
+	}
+}
+
+FBlueprintAuditor::FSectionCache& UBlueprintAuditSubsystem::FindOrAddSectionCache(const FString& BlueprintPath)
+{
+	SectionCacheOrder.Remove(BlueprintPath);
+	SectionCacheOrder.Add(BlueprintPath);
+	while (SectionCacheOrder.Num() > CVarAuditSectionCacheSize.GetValueOnGameThread() && SectionCacheOrder.Num() > 1)
+	{
+		SectionCaches.Remove(SectionCacheOrder[0]);
+		SectionCacheOrder.RemoveAt(0);
+	}
+	return SectionCaches.FindOrAdd(BlueprintPath);
+}
+
+FBlueprintAuditBundle* UBlueprintAuditSubsystem::GetBundle()
+{
+	if (!Bundle && CVarAuditBundle.GetValueOnGameThread())
+	{
+		Bundle = FBlueprintAuditBundle::Open(FBlueprintAuditBundle::GetDefaultPath(), CVarAuditBundleCompress.GetValueOnGameThread());
+
+		// Only what the bundle has no record of is read, so this is cheap once a -Bundle run has filled it
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		if (Bundle && !bBundleSeeded && !AssetRegistry.IsLoadingAssets())
+		{
+			bBundleSeeded = true;
+
+			int32 SkipCount = 0;
+			TArray<FBlueprintAuditWorkItem> Items;
+			TSet<FString> LivePackages;
+			for (const FAssetData& Asset : FBlueprintAuditBatch::GetProjectBlueprints(AssetRegistry, SkipCount))
+			{
+				FBlueprintAuditWorkItem& Item = Items.Add_GetRef(FBlueprintAuditBatch::MakeWorkItem(Asset));
+				LivePackages.Add(Item.PackageName);
+			}
+			const int32 RemovedCount = Bundle->RemoveAllExcept(LivePackages);
+			const int32 SeededCount = FBlueprintAuditBatch::PackTreeIntoBundle(*Bundle, Items, false);
+			if (SeededCount > 0 || RemovedCount > 0)
+			{
+				UE_LOG(LogCoRider, Display, TEXT("CoRider: Seeded bundle from the audit tree — %d added, %d removed"), SeededCount, RemovedCount);
+			}
+		}
+	}
+	return Bundle.Get();
+}
+
+void UBlueprintAuditSubsystem::PutInBundle(const FString& PackageName, const FBlueprintAuditData& Audit)
+{
+	if (FBlueprintAuditBundle* OpenBundle = GetBundle())
+	{
+		// Always compact, whatever CoRider.Audit.PrettyJson says about the tree
+		TArray<uint8> Json;
+		FMemoryWriter JsonWriter(Json);
+		FBlueprintAuditor::SerializeAuditJson(Audit, JsonWriter);
+		OpenBundle->Put(PackageName, Json);
+	}
+}
+
+void UBlueprintAuditSubsystem::RemoveFromBundle(const FString& PackageName)
+{
+	if (FBlueprintAuditBundle* OpenBundle = GetBundle())
+	{
+		OpenBundle->Remove(PackageName);
+	}
+}
+
+void UBlueprintAuditSubsystem::CommitBundle()
+{
+	if (Bundle)
+	{
+		Bundle->Commit();
+		Bundle.Reset();
+	}
 }
 
 void UBlueprintAuditSubsystem::OnAssetRemoved(const FAssetData& AssetData)
@@ -98,6 +306,19 @@ void UBlueprintAuditSubsystem::OnAssetRemoved(const FAssetData& AssetData)
 
 	const FString JsonPath = FBlueprintAuditor::GetAuditOutputPath(PackageName);
 	FBlueprintAuditor::DeleteAuditJson(JsonPath);
+
+	const FString ObjectPath = AssetData.GetObjectPathString();
+	SectionCaches.Remove(ObjectPath);
+	SectionCacheOrder.Remove(ObjectPath);
+
+	FBlueprintAuditHashCache::Get().Remove(PackageName);
+	RequestHashCacheSave();
+
+	RemoveFromBundle(PackageName);
+	if (BurstTotal == 0)
+	{
+		CommitBundle();
+	}
 }
 
 void UBlueprintAuditSubsystem::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
@@ -115,175 +336,525 @@ void UBlueprintAuditSubsystem::OnAssetRenamed(const FAssetData& AssetData, const
 
 	const FString OldJsonPath = FBlueprintAuditor::GetAuditOutputPath(OldPackageName);
 	FBlueprintAuditor::DeleteAuditJson(OldJsonPath);
+
+	FBlueprintAuditHashCache::Get().Remove(OldPackageName);
+	RequestHashCacheSave();
+
+	// The new path is put once the renamed package is saved
+	RemoveFromBundle(OldPackageName);
+	if (BurstTotal == 0)
+	{
+		CommitBundle();
+	}
 }
 
-bool UBlueprintAuditSubsystem::OnStaleCheckTick(float DeltaTime)
+void UBlueprintAuditSubsystem::OnContentDirectoryChanged(const TArray<FFileChangeData>& FileChanges)
 {
-	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
-	if (AssetRegistry.IsLoadingAssets())
+	for (const FFileChangeData& Change : FileChanges)
 	{
-		UE_LOG(LogCoRider, Verbose, TEXT("CoRider: Asset registry still loading, deferring stale check..."));
-		return true;
+		if (Change.Action == FFileChangeData::FCA_RescanRequired)
+		{
+			// The watcher dropped events (e.g. its buffer overflowed): only a full stale check is reliable
+			UE_LOG(LogCoRider, Display, TEXT("CoRider: Directory watcher requested a rescan — re-running the stale check"));
+			bRescanRequested = true;
+			continue;
+		}
+
+		// Deletions reach OnAssetRemoved through the registry
+		if (Change.Action == FFileChangeData::FCA_Removed || !FPaths::GetExtension(Change.Filename, true).Equals(FPackageName::GetAssetPackageExtension()))
+		{
+			continue;
+		}
+
+		ChangedFiles.Add(FPaths::ConvertRelativePathToFull(Change.Filename));
+		LastFileChangeTime = FPlatformTime::Seconds();
+	}
+}
+
+bool UBlueprintAuditSubsystem::OnBackgroundTick(float DeltaTime)
+{
+	if (!bStaleCheckStarted)
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		if (AssetRegistry.IsLoadingAssets())
+		{
+			UE_LOG(LogCoRider, Verbose, TEXT("CoRider: Asset registry still loading, deferring stale check..."));
+			return true;
+		}
+		StartStaleCheck();
+	}
+
+	if (CheckFuture.IsValid() && CheckFuture.IsReady())
+	{
+		FStaleCheckResult CheckResult = CheckFuture.Get();
+		CheckFuture.Reset();
+
+		UE_LOG(LogCoRider, Display, TEXT("CoRider: %s — %d scanned, %d up-to-date, %d queued for re-audit in %.2fs"),
+			CheckResult.Label, CheckResult.ScannedCount, CheckResult.UpToDateCount, CheckResult.StaleItems.Num(), CheckResult.Seconds);
+
+		const TSet<FString> OpenPackages = GetOpenPackageNames();
+		for (FBlueprintAuditWorkItem& Item : CheckResult.StaleItems)
+		{
+			// Already re-audited (e.g. requested or saved) after the check read its output
+			if (AuditedDuringCheck.Contains(Item.PackageName))
+			{
+				continue;
+			}
+			const bool bOpen = OpenPackages.Contains(Item.PackageName);
+			EnqueueAudit(MoveTemp(Item), bOpen ? EBlueprintAuditPriority::OpenInEditor : CheckResult.Priority);
+		}
+		AuditedDuringCheck.Reset();
+		RequestHashCacheSave();
+	}
+
+	if (HashCacheSaveTime > 0.0 && FPlatformTime::Seconds() >= HashCacheSaveTime && !IsUserInteracting())
+	{
+		HashCacheSaveTime = 0.0;
+		SaveHashCache();
+	}
+
+	if (bRescanRequested && !CheckFuture.IsValid())
+	{
+		bRescanRequested = false;
+		ChangedFiles.Reset();
+		FilesToResolve.Reset();
+		ChangedItems.Reset();
+		StartStaleCheck();
+	}
+
+	// A burst of changes (a sync) is handled once it has been quiet for a moment
+	if (FilesToResolve.IsEmpty() && ChangedFiles.Num() > 0
+		&& FPlatformTime::Seconds() - LastFileChangeTime >= CVarAuditWatchCoalesceSeconds.GetValueOnGameThread())
+	{
+		FilesToResolve = ChangedFiles.Array();
+		ChangedFiles.Reset();
+	}
+
+	// Auditing a loaded Blueprint and garbage collection are both game-thread work, so they wait until the user is idle
+	const double Deadline = FPlatformTime::Seconds() + CVarAuditBackgroundBudgetMs.GetValueOnGameThread() / 1000.0;
+	if (!IsUserInteracting())
+	{
+		if (BurstGCPolicy.IsSet())
+		{
+			BurstGCPolicy->CollectIfDue();
+		}
+		ResolveChangedFiles(Deadline);
+		ProcessPendingAudits(Deadline);
+	}
+	else if (PendingAudits.Num() > 0 && PendingAudits.HeapTop().Priority == EBlueprintAuditPriority::Requested)
+	{
+		// Requested Blueprints are wanted right now, so they don't wait for the user to go idle; nothing else does
+		ProcessPendingAudits(Deadline, true);
+	}
+
+	if (BurstTotal > 0)
+	{
+		if (PendingAudits.IsEmpty() && Loads.IsEmpty())
+		{
+			FinishBackgroundBurst();
+		}
+		else
+		{
+			UpdateProgressNotification();
+		}
 	}
 
-	AuditStaleBlueprints();
+	return true;
+}
 
-	// Return false to unregister — this is a one-shot check
-	StaleCheckTickerHandle.Reset();
-	return false;
+void UBlueprintAuditSubsystem::NoteAudited(const FString& PackageName)
+{
+	if (CheckFuture.IsValid())
+	{
+		AuditedDuringCheck.Add(PackageName);
+	}
 }
 
-void UBlueprintAuditSubsystem::AuditStaleBlueprints()
+void UBlueprintAuditSubsystem::StartStaleCheck()
 {
+	bStaleCheckStarted = true;
+
 	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
 
-	TArray<FAssetData> AllBlueprints;
-	AssetRegistry.GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), AllBlueprints, true);
+	int32 SkipCount = 0;
+	TArray<FBlueprintAuditWorkItem> Items;
+	for (const FAssetData& Asset : FBlueprintAuditBatch::GetProjectBlueprints(AssetRegistry, SkipCount))
+	{
+		FBlueprintAuditWorkItem Item = FBlueprintAuditBatch::MakeWorkItem(Asset);
+		if (!Item.SourcePath.IsEmpty())
+		{
+			Items.Add(MoveTemp(Item));
+		}
+	}
 
-	const double StartTime = FPlatformTime::Seconds();
-	int32 TotalScanned = 0;
-	int32 UpToDateCount = 0;
-	int32 ReAuditedCount = 0;
-	int32 FailedCount = 0;
+	StartUpToDateCheck(MoveTemp(Items), TEXT("Stale check"), EBlueprintAuditPriority::Background, true);
+}
 
-	int32 AssetsSinceGC = 0;
-	constexpr int32 GCInterval = 50;
+void UBlueprintAuditSubsystem::StartUpToDateCheck(TArray<FBlueprintAuditWorkItem>&& Items, const TCHAR* Label, EBlueprintAuditPriority Priority, bool bCleanUpAuditTree)
+{
+	check(!CheckFuture.IsValid());
+	AuditedDuringCheck.Reset();
 
-	for (const FAssetData& Asset : AllBlueprints)
+	// Registry lookups, stored-hash reads and fallback hashing are all thread-safe; only loading needs the game thread
+	CheckFuture = Async(EAsyncExecution::ThreadPool, [Items = MoveTemp(Items), Label, Priority, bCleanUpAuditTree]() mutable
 	{
-		const FString PackageName = Asset.PackageName.ToString();
+		const double StartTime = FPlatformTime::Seconds();
 
-		// Filter: Only audit project content (starts with /Game/)
-		if (!PackageName.StartsWith(TEXT("/Game/")))
+		FStaleCheckResult CheckResult;
+		CheckResult.Label = Label;
+		CheckResult.Priority = Priority;
+		CheckResult.ScannedCount = Items.Num();
+		CheckResult.UpToDateCount = FBlueprintAuditBatch::RemoveUpToDateItems(Items);
+		CheckResult.StaleItems = MoveTemp(Items);
+
+		// Same off-thread slot: orphaned audits and whole directories from older schema versions (both log bytes reclaimed)
+		if (bCleanUpAuditTree)
 		{
-			continue;
+			FBlueprintAuditor::SweepOrphanedAuditFiles();
+			FBlueprintAuditor::DeleteOldAuditVersions();
 		}
 
-		++TotalScanned;
+		CheckResult.Seconds = FPlatformTime::Seconds() - StartTime;
+		return CheckResult;
+	});
+}
 
-		const FString JsonPath = FBlueprintAuditor::GetAuditOutputPath(PackageName);
-		const FString SourcePath = FBlueprintAuditor::GetSourceFilePath(PackageName);
+void UBlueprintAuditSubsystem::ResolveChangedFiles(double Deadline)
+{
+	// Refresh the registry for the changed files a few at a time, then check only those Blueprints
+	constexpr int32 FilesPerSlice = 8;
+	while (FilesToResolve.Num() > 0 && FPlatformTime::Seconds() < Deadline)
+	{
+		const int32 SliceCount = FMath::Min(FilesPerSlice, FilesToResolve.Num());
+		const TArray<FString> Slice(FilesToResolve.GetData() + FilesToResolve.Num() - SliceCount, SliceCount);
+		FilesToResolve.RemoveAt(FilesToResolve.Num() - SliceCount, SliceCount);
 
-		if (SourcePath.IsEmpty())
+		TArray<FString> MissingPackages;
+		FBlueprintAuditBatch::ResolveAssetList(Slice, ChangedItems, MissingPackages, true);
+		for (const FString& PackageName : MissingPackages)
 		{
-			++FailedCount;
-			continue;
+			FBlueprintAuditor::DeleteAuditJson(FBlueprintAuditor::GetAuditOutputPath(PackageName));
+			FBlueprintAuditHashCache::Get().Remove(PackageName);
+			RemoveFromBundle(PackageName);
 		}
+	}
+	if (BurstTotal == 0)
+	{
+		CommitBundle();
+	}
 
-		// Compute current .uasset hash
-		const FString CurrentHash = FBlueprintAuditor::ComputeFileHash(SourcePath);
-		if (CurrentHash.IsEmpty())
+	if (FilesToResolve.IsEmpty() && ChangedItems.Num() > 0 && !CheckFuture.IsValid())
+	{
+		StartUpToDateCheck(MoveTemp(ChangedItems), TEXT("Content change check"), EBlueprintAuditPriority::RecentlySaved, false);
+		ChangedItems.Reset();
+	}
+}
+
+bool UBlueprintAuditSubsystem::RequestAudit(const FBlueprintAuditWorkItem& Item, EBlueprintAuditPriority Priority)
+{
+	if (FindLoad(Item.PackageName) || PendingPackages.Contains(Item.PackageName))
+	{
+		EnqueueAudit(CopyTemp(Item), Priority);
+		return true;
+	}
+
+	// A single check is a registry lookup and a small read; no need to wait for the background check
+	FBlueprintAuditWorkItem Checked = Item;
+	if (Checked.SourcePath.IsEmpty()
+		|| FBlueprintAuditor::IsAuditUpToDate(Checked.PackageName, Checked.SourcePath, Checked.OutputPath, &Checked.SourceFileHash))
+	{
+		return false;
+	}
+
+	EnqueueAudit(MoveTemp(Checked), Priority);
+	return true;
+}
+
+void UBlueprintAuditSubsystem::EnqueueAudit(FBlueprintAuditWorkItem&& Item, EBlueprintAuditPriority Priority)
+{
+	// Already loading: only its priority can change, so a requested audit isn't held back
+	if (FBackgroundLoad* Load = FindLoad(Item.PackageName))
+	{
+		Load->Priority = FMath::Min(Load->Priority, Priority);
+		return;
+	}
+
+	if (PendingPackages.Contains(Item.PackageName))
+	{
+		FPendingAudit* Pending = PendingAudits.FindByPredicate([&Item](const FPendingAudit& Existing) { return Existing.Item.PackageName == Item.PackageName; });
+		if (Pending && Priority < Pending->Priority)
 		{
-			++FailedCount;
-			continue;
+			Pending->Priority = Priority;
+			PendingAudits.Heapify();
 		}
+		return;
+	}
+
+	if (BurstTotal == 0)
+	{
+		BurstStartTime = FPlatformTime::Seconds();
+		BurstGCPolicy.Emplace();
+	}
+	++BurstTotal;
 
-		// Read stored hash from existing JSON (if any)
-		FString StoredHash;
-		FString JsonString;
-		if (FFileHelper::LoadFileToString(JsonString, *JsonPath))
+	PendingPackages.Add(Item.PackageName);
+	PendingAudits.HeapPush({ MoveTemp(Item), Priority, NextPendingSequence++ });
+}
+
+void UBlueprintAuditSubsystem::OnAssetOpenedInEditor(UObject* Asset, IAssetEditorInstance* EditorInstance)
+{
+	if (const UBlueprint* BP = Cast<UBlueprint>(Asset))
+	{
+		const FString PackageName = BP->GetOutermost()->GetName();
+		if (PendingPackages.Contains(PackageName))
 		{
-			TSharedPtr<FJsonObject> ExistingJson;
-			const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
-			if (FJsonSerializer::Deserialize(Reader, ExistingJson) && ExistingJson.IsValid())
-			{
-				StoredHash = ExistingJson->GetStringField(TEXT("SourceFileHash"));
-			}
-			else
+			EnqueueAudit(FBlueprintAuditBatch::MakeWorkItem(FAssetData(BP)), EBlueprintAuditPriority::OpenInEditor);
+		}
+	}
+}
+
+TSet<FString> UBlueprintAuditSubsystem::GetOpenPackageNames() const
+{
+	TSet<FString> PackageNames;
+	if (AssetEditorSubsystem.IsValid())
+	{
+		for (const UObject* Asset : AssetEditorSubsystem->GetAllEditedAssets())
+		{
+			if (Asset)
 			{
-				UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to parse existing audit JSON for %s"), *PackageName);
+				PackageNames.Add(Asset->GetOutermost()->GetName());
 			}
 		}
+	}
+	return PackageNames;
+}
 
-		// Skip if hash matches — this Blueprint is up to date
-		if (CurrentHash == StoredHash)
+void UBlueprintAuditSubsystem::ProcessPendingAudits(double Deadline, bool bRequestedOnly)
+{
+	while (FPlatformTime::Seconds() < Deadline)
+	{
+		const int32 DoneIndex = Loads.IndexOfByPredicate([bRequestedOnly](const FBackgroundLoad& Load)
+		{
+			return Load.bDone && (!bRequestedOnly || Load.Priority == EBlueprintAuditPriority::Requested);
+		});
+		if (DoneIndex != INDEX_NONE)
 		{
-			UE_LOG(LogCoRider, Verbose, TEXT("CoRider: %s is up-to-date, skipping"), *PackageName);
-			++UpToDateCount;
+			FinishLoadedAudit(DoneIndex);
 			continue;
 		}
 
-		// Stale or missing — load the Blueprint and re-audit
-		UBlueprint* BP = Cast<UBlueprint>(Asset.GetAsset());
-		if (!BP)
+		// Requested Blueprints may start past the in-flight limit rather than wait behind background loads
+		if (PendingAudits.IsEmpty())
 		{
-			++FailedCount;
-			UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to load asset %s for re-audit"), *PackageName);
-			continue;
+			return;
+		}
+		const bool bNextRequested = PendingAudits.HeapTop().Priority == EBlueprintAuditPriority::Requested;
+		if ((bRequestedOnly && !bNextRequested)
+			|| (!bNextRequested && Loads.Num() >= FMath::Max(CVarAuditBackgroundLoads.GetValueOnGameThread(), 1)))
+		{
+			// Async loading is processed by the engine tick; check back next frame
+			return;
 		}
+		StartNextLoad();
+	}
+}
 
-		const TSharedPtr<FJsonObject> AuditJson = FBlueprintAuditor::AuditBlueprint(BP);
-		FBlueprintAuditor::WriteAuditJson(AuditJson, JsonPath);
-		++ReAuditedCount;
+void UBlueprintAuditSubsystem::StartNextLoad()
+{
+	FPendingAudit Next;
+	PendingAudits.HeapPop(Next);
+	PendingPackages.Remove(Next.Item.PackageName);
 
-		if (++AssetsSinceGC >= GCInterval)
+	// Already in memory (e.g. open in an editor): no load needed
+	if (UPackage* Resident = FindPackage(nullptr, *Next.Item.PackageName))
+	{
+		// The audit records the disk file's hash, so the in-memory copy must match that file.
+		// Unsaved edits are audited by OnPackageSaved; a copy the disk has moved past waits for a reload.
+		if (!IsResidentPackageCurrent(Resident))
 		{
-			CollectGarbage(RF_NoFlags);
-			AssetsSinceGC = 0;
+			UE_LOG(LogCoRider, Verbose, TEXT("CoRider: Skipping background audit of %s — the loaded package differs from the file on disk"),
+				*Next.Item.PackageName);
+			++BurstSkipped;
+			return;
 		}
+
+		FBackgroundLoad& Load = Loads.AddDefaulted_GetRef();
+		Load.Item = MoveTemp(Next.Item);
+		Load.Priority = Next.Priority;
+		Load.bDone = true;
+		Load.Package.Reset(Resident);
+		HoldAssets(Load);
+		return;
 	}
 
-	const double Elapsed = FPlatformTime::Seconds() - StartTime;
-	UE_LOG(LogCoRider, Display, TEXT("CoRider: Stale check complete: %d scanned, %d up-to-date, %d re-audited, %d failed in %.2fs"),
-		TotalScanned, UpToDateCount, ReAuditedCount, FailedCount, Elapsed);
+	const FString PackageName = Next.Item.PackageName;
+	FBackgroundLoad& Load = Loads.AddDefaulted_GetRef();
+	Load.Item = MoveTemp(Next.Item);
+	Load.Priority = Next.Priority;
+
+	TWeakObjectPtr<UBlueprintAuditSubsystem> WeakThis(this);
+	const int32 RequestId = LoadPackageAsync(PackageName,
+		FLoadPackageAsyncDelegate::CreateLambda([WeakThis](const FName& LoadedName, UPackage* LoadedPkg, EAsyncLoadingResult::Type Result)
+		{
+			UBlueprintAuditSubsystem* This = WeakThis.Get();
+			FBackgroundLoad* Finished = This ? This->FindLoad(LoadedName.ToString()) : nullptr;
+			if (!Finished || Finished->bDone)
+			{
+				return;
+			}
+			Finished->bDone = true;
+			if (Result == EAsyncLoadingResult::Succeeded && LoadedPkg)
+			{
+				Finished->Package.Reset(LoadedPkg);
+				HoldAssets(*Finished);
+			}
+		}));
+
+	// LoadPackageAsync can complete synchronously and fire the callback before returning
+	FBackgroundLoad* Started = FindLoad(PackageName);
+	if (Started && !Started->bDone)
+	{
+		Started->RequestId = RequestId;
+	}
+}
 
-	SweepOrphanedAuditFiles();
+void UBlueprintAuditSubsystem::HoldAssets(FBackgroundLoad& Load)
+{
+	ForEachObjectWithPackage(Load.Package.Get(), [&Load](UObject* Object)
+	{
+		if (Object->IsAsset())
+		{
+			Load.Assets.Emplace(Object);
+		}
+		return true;
+	}, false);
 }
 
-void UBlueprintAuditSubsystem::SweepOrphanedAuditFiles()
+UBlueprintAuditSubsystem::FBackgroundLoad* UBlueprintAuditSubsystem::FindLoad(const FString& PackageName)
 {
-	const FString BaseDir = FBlueprintAuditor::GetAuditBaseDir();
+	return Loads.FindByPredicate([&PackageName](const FBackgroundLoad& Load) { return Load.Item.PackageName == PackageName; });
+}
 
-	TArray<FString> JsonFiles;
-	IFileManager::Get().FindFilesRecursive(JsonFiles, *BaseDir, TEXT("*.json"), true, false);
+void UBlueprintAuditSubsystem::FinishLoadedAudit(int32 Index)
+{
+	const FBackgroundLoad Load = MoveTemp(Loads[Index]);
+	Loads.RemoveAt(Index);
+	const FBlueprintAuditWorkItem& Item = Load.Item;
 
-	if (JsonFiles.IsEmpty())
+	UBlueprint* BP = Load.Package ? Cast<UBlueprint>(Item.Asset.FastGetAsset(false)) : nullptr;
+	if (!BP)
 	{
+		++BurstFailed;
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to load asset %s for re-audit"), *Item.PackageName);
 		return;
 	}
 
-	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	// Reuse the hash the stale check computed when the registry had no saved hash
+	const FBlueprintAuditData Audit = FBlueprintAuditor::AuditBlueprint(BP, true, Item.SourceFileHash);
+	FBlueprintAuditor::WriteAuditJson(Audit, Item.OutputPath);
+	PutInBundle(Item.PackageName, Audit);
+	NoteAudited(Item.PackageName);
+	++BurstAudited;
 
-	int32 SweptCount = 0;
-	for (const FString& JsonFile : JsonFiles)
+	// Garbage is collected from the idle tick, never in the middle of a requested audit
+	if (BurstGCPolicy.IsSet())
 	{
-		// Convert absolute path back to a package name:
-		// Strip the base dir prefix and .json suffix, then prepend /Game/
-		FString RelPath = JsonFile;
-		if (!RelPath.StartsWith(BaseDir))
-		{
-			continue;
-		}
-		RelPath.RightChopInline(BaseDir.Len());
+		BurstGCPolicy->AddAsset();
+	}
+}
 
-		// Remove leading separator if present
-		if (RelPath.StartsWith(TEXT("/")) || RelPath.StartsWith(TEXT("\\")))
-		{
-			RelPath.RightChopInline(1);
-		}
+bool UBlueprintAuditSubsystem::IsResidentPackageCurrent(const UPackage* Package)
+{
+	if (Package->IsDirty())
+	{
+		return false;
+	}
 
-		// Remove .json suffix
-		if (RelPath.EndsWith(TEXT(".json")))
-		{
-			RelPath.LeftChopInline(5);
-		}
+	// The loaded package keeps the saved hash of the bytes it came from; the registry has the file's current one
+	const FIoHash LoadedHash = Package->GetSavedHash();
+	const FString DiskHash = FBlueprintAuditor::GetPackageSavedHash(Package->GetName());
+	return LoadedHash.IsZero() || DiskHash.IsEmpty() || LexToString(LoadedHash) == DiskHash;
+}
 
-		// Normalize separators for the package path
-		RelPath.ReplaceInline(TEXT("\\"), TEXT("/"));
+bool UBlueprintAuditSubsystem::IsUserInteracting()
+{
+	if (!FSlateApplication::IsInitialized())
+	{
+		return false;
+	}
+	const FSlateApplication& SlateApp = FSlateApplication::Get();
+	return SlateApp.GetCurrentTime() - SlateApp.GetLastUserInteractionTime() < CVarAuditBackgroundIdleSeconds.GetValueOnGameThread();
+}
 
-		const FString PackageName = TEXT("/Game/") + RelPath;
+void UBlueprintAuditSubsystem::UpdateProgressNotification()
+{
+	if (!FSlateApplication::IsInitialized())
+	{
+		return;
+	}
+
+	const FText Text = FText::Format(LOCTEXT("AuditProgress", "CoRider: auditing Blueprints ({0} / {1})"),
+		FText::AsNumber(BurstAudited + BurstFailed + BurstSkipped), FText::AsNumber(BurstTotal));
 
-		TArray<FAssetData> Assets;
-		AssetRegistry.GetAssetsByPackageName(FName(*PackageName), Assets, true);
-		if (Assets.IsEmpty())
+	if (!ProgressNotification.IsValid())
+	{
+		FNotificationInfo Info(Text);
+		Info.bFireAndForget = false;
+		Info.bUseThrobber = true;
+		Info.FadeOutDuration = 1.0f;
+		ProgressNotification = FSlateNotificationManager::Get().AddNotification(Info);
+		if (ProgressNotification.IsValid())
 		{
-			FBlueprintAuditor::DeleteAuditJson(JsonFile);
-			++SweptCount;
+			ProgressNotification->SetCompletionState(SNotificationItem::CS_Pending);
 		}
+		return;
 	}
 
-	if (SweptCount > 0)
+	ProgressNotification->SetText(Text);
+}
+
+void UBlueprintAuditSubsystem::RequestHashCacheSave()
+{
+	if (HashCacheSaveTime <= 0.0)
+	{
+		HashCacheSaveTime = FPlatformTime::Seconds() + HashCacheSaveDelaySeconds;
+	}
+}
+
+void UBlueprintAuditSubsystem::SaveHashCache()
+{
+	// Never wait on another process's save from the game thread; try again after the usual delay
+	if (!FBlueprintAuditHashCache::Get().Save(0.0))
+	{
+		RequestHashCacheSave();
+	}
+}
+
+void UBlueprintAuditSubsystem::FinishBackgroundBurst()
+{
+	const int32 GCCount = BurstGCPolicy.IsSet() ? BurstGCPolicy->GetCollectCount() : 0;
+	const double GCSeconds = BurstGCPolicy.IsSet() ? BurstGCPolicy->GetCollectSeconds() : 0.0;
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Background audits complete — %d re-audited, %d failed, %d skipped (changed in memory), %d GC(s) (%.2fs) in %.2fs"),
+		BurstAudited, BurstFailed, BurstSkipped, GCCount, GCSeconds, FPlatformTime::Seconds() - BurstStartTime);
+
+	if (ProgressNotification.IsValid())
 	{
-		UE_LOG(LogCoRider, Display, TEXT("CoRider: Swept %d orphaned audit file(s)"), SweptCount);
+		ProgressNotification->SetText(FText::Format(LOCTEXT("AuditDone", "CoRider: {0} Blueprint audit(s) refreshed"), FText::AsNumber(BurstAudited)));
+		ProgressNotification->SetCompletionState(BurstFailed > 0 ? SNotificationItem::CS_Fail : SNotificationItem::CS_Success);
+		ProgressNotification->ExpireAndFadeout();
+		ProgressNotification.Reset();
 	}
+
+	HashCacheSaveTime = 0.0;
+	SaveHashCache();
+
+	BurstTotal = 0;
+	BurstAudited = 0;
+	BurstFailed = 0;
+	BurstSkipped = 0;
+	BurstGCPolicy.Reset();
+
+	CommitBundle();
 }
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,611 @@
+#include "BlueprintAuditWorkers.h"
+
+#include "BlueprintAuditor.h"
+#include "BlueprintAuditBundle.h"
+#include "BlueprintAuditCheckpoint.h"
+#include "BlueprintAuditGCPolicy.h"
+#include "BlueprintAuditStream.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+/** Relaunches allowed per worker slot after a crash. Clean exits with work left are always relaunched. */
+static constexpr int32 MaxCrashRelaunchesPerWorker = 3;
+
+/** A package in flight during this many child crashes is quarantined instead of retried. */
+static constexpr int32 MaxCrashesPerPackage = 2;
+
+static FString GetPendingDir(const FString& QueueDir) { return QueueDir / TEXT("pending"); }
+static FString GetClaimedDir(const FString& QueueDir) { return QueueDir / TEXT("claimed"); }
+static FString GetProgressDir(const FString& QueueDir) { return QueueDir / TEXT("progress"); }
+static FString GetResultsDir(const FString& QueueDir) { return QueueDir / TEXT("results"); }
+static FString GetLogsDir(const FString& QueueDir) { return QueueDir / TEXT("logs"); }
+static FString GetStreamDir(const FString& QueueDir) { return QueueDir / TEXT("stream"); }
+
+/**
+ * Worker journal for a claimed batch: "begin" before each load, "done"/"failed" once its write has landed.
+ * Left behind when the batch finishes; the parent picks it up once the claim is gone.
+ */
+static FString GetProgressName(const FString& ClaimedPath) { return FPaths::GetBaseFilename(ClaimedPath); }
+static FString GetProgressPath(const FString& QueueDir, const FString& ClaimedPath)
+{
+	return GetProgressDir(QueueDir) / GetProgressName(ClaimedPath) + TEXT(".journal");
+}
+
+static TArray<FString> ReadLines(const FString& FilePath)
+{
+	TArray<FString> Lines;
+	FFileHelper::LoadFileToStringArray(Lines, *FilePath);
+	Lines.RemoveAll([](const FString& Line) { return Line.TrimStartAndEnd().IsEmpty(); });
+	return Lines;
+}
+
+static bool WriteLines(const FString& FilePath, const TArray<FString>& Lines)
+{
+	return FFileHelper::SaveStringToFile(FString::Join(Lines, TEXT("\n")) + TEXT("\n"), *FilePath,
+		FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+static int32 CountFiles(const FString& Directory)
+{
+	TArray<FString> Files;
+	IFileManager::Get().FindFiles(Files, *(Directory / TEXT("*.txt")), true, false);
+	return Files.Num();
+}
+
+/** Atomically move the first pending batch into claimed/. Returns false when no batches are left. */
+static bool ClaimNextBatch(const FString& QueueDir, int32 WorkerId, FString& OutClaimedPath)
+{
+	IFileManager& FileManager = IFileManager::Get();
+
+	TArray<FString> PendingFiles;
+	FileManager.FindFiles(PendingFiles, *(GetPendingDir(QueueDir) / TEXT("*.txt")), true, false);
+	PendingFiles.Sort();
+
+	for (const FString& FileName : PendingFiles)
+	{
+		const FString ClaimedPath = GetClaimedDir(QueueDir) / FString::Printf(TEXT("w%d-%s"), WorkerId, *FileName);
+
+		// Rename is atomic: if another worker claimed it first, the source is gone and Move fails
+		if (FileManager.Move(*ClaimedPath, *(GetPendingDir(QueueDir) / FileName), false, false, false, true))
+		{
+			OutClaimedPath = ClaimedPath;
+			return true;
+		}
+	}
+	return false;
+}
+
+/** Read whole keyed records (package, tab, JSON) that children appended to their stream files since the last call. */
+static void ReadWorkerStreams(const FString& QueueDir, TMap<FString, int64>& Offsets,
+	TFunctionRef<void(const FString& PackageName, const ANSICHAR* Json, int32 Length)> OnRecord)
+{
+	TArray<FString> StreamFiles;
+	IFileManager::Get().FindFiles(StreamFiles, *(GetStreamDir(QueueDir) / TEXT("*.ndjson")), true, false);
+
+	for (const FString& FileName : StreamFiles)
+	{
+		int64& Offset = Offsets.FindOrAdd(FileName);
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*(GetStreamDir(QueueDir) / FileName), FILEREAD_AllowWrite));
+		if (!Reader || Reader->TotalSize() <= Offset)
+		{
+			continue;
+		}
+
+		TArray<uint8> Bytes;
+		Bytes.SetNumUninitialized(Reader->TotalSize() - Offset);
+		Reader->Seek(Offset);
+		Reader->Serialize(Bytes.GetData(), Bytes.Num());
+
+		// A record still being written is picked up on the next call
+		int32 LineStart = 0;
+		for (int32 Index = 0; Index < Bytes.Num(); ++Index)
+		{
+			if (Bytes[Index] != '\n')
+			{
+				continue;
+			}
+			const ANSICHAR* Line = reinterpret_cast<const ANSICHAR*>(Bytes.GetData() + LineStart);
+			const int32 LineLength = Index - LineStart;
+			LineStart = Index + 1;
+
+			int32 KeyLength = 0;
+			while (KeyLength < LineLength && Line[KeyLength] != '\t')
+			{
+				++KeyLength;
+			}
+			if (KeyLength < LineLength)
+			{
+				const FUTF8ToTCHAR Key(Line, KeyLength);
+				OnRecord(FString(Key.Length(), Key.Get()), Line + KeyLength + 1, LineLength - KeyLength - 1);
+			}
+		}
+		Offset += LineStart;
+	}
+}
+
+static FProcHandle LaunchWorker(const FString& QueueDir, int32 WorkerId, int32 Launch,
+	const FBlueprintAuditBatchOptions& Options, uint32& OutProcessId)
+{
+	const FString ProjectFile = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+	const FString LogFile = GetLogsDir(QueueDir) / FString::Printf(TEXT("worker-%d-%d.log"), WorkerId, Launch);
+	const FString Args = FString::Printf(
+		TEXT("\"%s\" -run=BlueprintAudit -WorkerQueue=\"%s\" -WorkerId=%d %s -abslog=\"%s\" -unattended -nopause -nosplash -nullrhi"),
+		*ProjectFile, *QueueDir, WorkerId, *Options.ToParams(), *LogFile);
+
+	return FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Args,
+		false, true, true, &OutProcessId, 0, nullptr, nullptr);
+}
+
+FBlueprintAuditBatchResult FBlueprintAuditWorkers::RunOrchestrator(const TArray<FBlueprintAuditWorkItem>& WorkItems,
+	int32 NumWorkers, int32 BatchSize, const FBlueprintAuditBatchOptions& Options, FBlueprintAuditCheckpoint* Checkpoint)
+{
+	FBlueprintAuditBatchResult Result;
+	const double StartTime = FPlatformTime::Seconds();
+	IFileManager& FileManager = IFileManager::Get();
+
+	const FString RunId = FString::Printf(TEXT("%s-%u"),
+		*FDateTime::UtcNow().ToString(TEXT("%Y%m%d-%H%M%S")), FPlatformProcess::GetCurrentProcessId());
+	const FString QueueDir = FBlueprintAuditor::GetAuditVersionDir() / TEXT("Workers") / RunId;
+	for (const FString& Dir : { GetPendingDir(QueueDir), GetClaimedDir(QueueDir), GetProgressDir(QueueDir), GetResultsDir(QueueDir), GetLogsDir(QueueDir), GetStreamDir(QueueDir) })
+	{
+		FileManager.MakeDirectory(*Dir, true);
+	}
+
+	// Every child would otherwise assume the whole machine's memory budget for itself
+	FBlueprintAuditBatchOptions ChildOptions = Options;
+	ChildOptions.GCBudgetMB = FMath::Max(FBlueprintAuditGCPolicy::ResolveBudgetMB(Options.GCBudgetMB) / NumWorkers, 1);
+
+	// Small batches so early finishers keep claiming work; several per worker at minimum
+	if (BatchSize <= 0)
+	{
+		BatchSize = FMath::Clamp(WorkItems.Num() / (NumWorkers * 8), 8, 200);
+	}
+
+	int32 NextBatchId = 0;
+	for (int32 Start = 0; Start < WorkItems.Num(); Start += BatchSize)
+	{
+		TArray<FString> Packages;
+		for (int32 Index = Start; Index < FMath::Min(Start + BatchSize, WorkItems.Num()); ++Index)
+		{
+			Packages.Add(WorkItems[Index].PackageName);
+		}
+		WriteLines(GetPendingDir(QueueDir) / FString::Printf(TEXT("batch-%05d.txt"), NextBatchId++), Packages);
+	}
+	const int32 InitialBatchCount = NextBatchId;
+
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Dispatching %d Blueprint(s) in %d batch(es) to %d worker process(es) via %s"),
+		WorkItems.Num(), InitialBatchCount, NumWorkers, *QueueDir);
+
+	struct FWorkerSlot
+	{
+		FProcHandle Handle;
+		uint32 ProcessId = 0;
+		int32 Launches = 0;
+		int32 Crashes = 0;
+		bool bRunning = false;
+	};
+
+	TArray<FWorkerSlot> Workers;
+	Workers.SetNum(NumWorkers);
+
+	auto Launch = [&](int32 WorkerId)
+	{
+		FWorkerSlot& Slot = Workers[WorkerId];
+		Slot.Handle = LaunchWorker(QueueDir, WorkerId, Slot.Launches, ChildOptions, Slot.ProcessId);
+		++Slot.Launches;
+		Slot.bRunning = Slot.Handle.IsValid();
+		if (!Slot.bRunning)
+		{
+			// Counted as a crash so a slot that can't start doesn't retry forever
+			++Slot.Crashes;
+			UE_LOG(LogCoRider, Error, TEXT("CoRider: Failed to launch worker %d"), WorkerId);
+		}
+	};
+
+	TMap<FString, int32> CrashCounts;
+	TArray<FString> Quarantined;
+	TSet<FString> RecoveredFailed;
+
+	TMap<FString, const FBlueprintAuditWorkItem*> ItemsByPackage;
+	for (const FBlueprintAuditWorkItem& Item : WorkItems)
+	{
+		ItemsByPackage.Add(Item.PackageName, &Item);
+	}
+
+	// Children's stream records are forwarded once the package is journaled done, and only once: a relaunched
+	// child re-audits whatever its predecessor hadn't committed, and may already have streamed
+	TMap<FString, int64> StreamOffsets;
+	TMap<FString, TArray<ANSICHAR>> HeldRecords;
+	TSet<FString> CommittedPackages;
+	TSet<FString> StreamedPackages;
+	auto ForwardRecord = [&](const FString& PackageName, const ANSICHAR* Json, int32 Length)
+	{
+		bool bAlreadyStreamed = false;
+		StreamedPackages.Add(PackageName, &bAlreadyStreamed);
+		if (!bAlreadyStreamed)
+		{
+			Options.Stream->WriteRecord(PackageName, Json, Length);
+		}
+	};
+
+	// Journal a batch's final outcomes and pack what it wrote, as soon as the parent learns of them
+	auto RecordOutcomes = [&](const TMap<FString, FString>& States)
+	{
+		TArray<FBlueprintAuditWorkItem> DoneItems;
+		for (const TPair<FString, FString>& Entry : States)
+		{
+			if (Entry.Value == TEXT("done"))
+			{
+				if (Options.Stream)
+				{
+					CommittedPackages.Add(Entry.Key);
+					if (TArray<ANSICHAR>* Held = HeldRecords.Find(Entry.Key))
+					{
+						ForwardRecord(Entry.Key, Held->GetData(), Held->Num());
+						HeldRecords.Remove(Entry.Key);
+					}
+				}
+				if (Checkpoint)
+				{
+					Checkpoint->MarkDone(Entry.Key);
+				}
+				if (const FBlueprintAuditWorkItem* const* Item = ItemsByPackage.Find(Entry.Key))
+				{
+					DoneItems.Add(**Item);
+				}
+			}
+			else if (Entry.Value == TEXT("failed") && Checkpoint)
+			{
+				Checkpoint->MarkFailed(Entry.Key);
+			}
+		}
+
+		// Children only write the tree
+		if (Options.Bundle && DoneItems.Num() > 0)
+		{
+			FBlueprintAuditBatch::PackTreeIntoBundle(*Options.Bundle, DoneItems, true);
+		}
+	};
+
+	// A journal whose claim is gone belongs to a batch its child finished
+	auto CollectFinishedBatches = [&]()
+	{
+		TArray<FString> ProgressFiles;
+		FileManager.FindFiles(ProgressFiles, *(GetProgressDir(QueueDir) / TEXT("*.journal")), true, false);
+		for (const FString& FileName : ProgressFiles)
+		{
+			const FString ProgressPath = GetProgressDir(QueueDir) / FileName;
+			if (!FileManager.FileExists(*(GetClaimedDir(QueueDir) / FPaths::GetBaseFilename(FileName) + TEXT(".txt"))))
+			{
+				RecordOutcomes(FBlueprintAuditCheckpoint::ReadStates(ProgressPath));
+				FileManager.Delete(*ProgressPath, false, false, true);
+			}
+		}
+	};
+
+	// Return whatever a dead worker had claimed but not finished to the pending queue
+	auto RecoverClaimedBatches = [&](int32 WorkerId, bool bCrashed)
+	{
+		TArray<FString> ClaimedFiles;
+		FileManager.FindFiles(ClaimedFiles, *(GetClaimedDir(QueueDir) / FString::Printf(TEXT("w%d-*.txt"), WorkerId)), true, false);
+
+		for (const FString& FileName : ClaimedFiles)
+		{
+			const FString ClaimedPath = GetClaimedDir(QueueDir) / FileName;
+			const FString ProgressPath = GetProgressPath(QueueDir, ClaimedPath);
+
+			// Only "done"/"failed" are final; an extracted audit whose write never landed is retried
+			const TMap<FString, FString> States = FBlueprintAuditCheckpoint::ReadStates(ProgressPath);
+			RecordOutcomes(States);
+			TArray<FString> Remaining;
+			for (const FString& PackageName : ReadLines(ClaimedPath))
+			{
+				const FString* State = States.Find(PackageName);
+				if (State && *State == TEXT("failed"))
+				{
+					RecoveredFailed.Add(PackageName);
+				}
+				else if (!State || *State != TEXT("done"))
+				{
+					Remaining.Add(PackageName);
+				}
+			}
+
+			// A package left at "begin" was being loaded or walked when the child died
+			if (bCrashed)
+			{
+				for (const TPair<FString, FString>& Entry : States)
+				{
+					if (Entry.Value == TEXT("begin") && ++CrashCounts.FindOrAdd(Entry.Key) >= MaxCrashesPerPackage)
+					{
+						UE_LOG(LogCoRider, Error, TEXT("CoRider: Quarantining %s after %d worker crash(es)"), *Entry.Key, MaxCrashesPerPackage);
+						Quarantined.Add(Entry.Key);
+						Remaining.Remove(Entry.Key);
+						if (Checkpoint)
+						{
+							Checkpoint->MarkQuarantined(Entry.Key);
+						}
+					}
+				}
+			}
+
+			if (Remaining.Num() > 0)
+			{
+				WriteLines(GetPendingDir(QueueDir) / FString::Printf(TEXT("batch-%05d.txt"), NextBatchId++), Remaining);
+				UE_LOG(LogCoRider, Warning, TEXT("CoRider: Re-queued %d unfinished Blueprint(s) from worker %d"), Remaining.Num(), WorkerId);
+			}
+
+			FileManager.Delete(*ClaimedPath, false, false, true);
+			FileManager.Delete(*ProgressPath, false, false, true);
+		}
+	};
+
+	for (int32 WorkerId = 0; WorkerId < NumWorkers; ++WorkerId)
+	{
+		Launch(WorkerId);
+	}
+
+	double LastProgressLog = FPlatformTime::Seconds();
+	for (;;)
+	{
+		bool bAnyRunning = false;
+		for (int32 WorkerId = 0; WorkerId < NumWorkers; ++WorkerId)
+		{
+			FWorkerSlot& Slot = Workers[WorkerId];
+			if (Slot.bRunning && FPlatformProcess::IsProcRunning(Slot.Handle))
+			{
+				bAnyRunning = true;
+				continue;
+			}
+
+			if (Slot.bRunning)
+			{
+				int32 ReturnCode = -1;
+				FPlatformProcess::GetProcReturnCode(Slot.Handle, &ReturnCode);
+				FPlatformProcess::CloseProc(Slot.Handle);
+				Slot.bRunning = false;
+
+				if (ReturnCode != 0)
+				{
+					++Slot.Crashes;
+					UE_LOG(LogCoRider, Warning, TEXT("CoRider: Worker %d (pid %u) exited with code %d"), WorkerId, Slot.ProcessId, ReturnCode);
+				}
+				RecoverClaimedBatches(WorkerId, ReturnCode != 0);
+			}
+
+			// Relaunch idle slots while work remains (re-queued batches included); only crashes use up the budget
+			if (CountFiles(GetPendingDir(QueueDir)) > 0 && Slot.Crashes <= MaxCrashRelaunchesPerWorker)
+			{
+				Launch(WorkerId);
+				bAnyRunning |= Slot.bRunning;
+			}
+		}
+
+		CollectFinishedBatches();
+
+		if (Options.Stream)
+		{
+			ReadWorkerStreams(QueueDir, StreamOffsets, [&](const FString& PackageName, const ANSICHAR* Json, int32 Length)
+			{
+				if (CommittedPackages.Contains(PackageName))
+				{
+					ForwardRecord(PackageName, Json, Length);
+				}
+				else if (!StreamedPackages.Contains(PackageName))
+				{
+					// Not journaled yet; a later record for the same package (after a relaunch) replaces this one
+					HeldRecords.Add(PackageName, TArray<ANSICHAR>(Json, Length));
+				}
+			});
+		}
+
+		if (!bAnyRunning)
+		{
+			break;
+		}
+
+		if (FPlatformTime::Seconds() - LastProgressLog >= 10.0)
+		{
+			LastProgressLog = FPlatformTime::Seconds();
+
+			// The journal already covers these; a killed parent re-packs whatever the bundle missed on -Resume
+			if (Options.Bundle)
+			{
+				Options.Bundle->Commit();
+			}
+			UE_LOG(LogCoRider, Display, TEXT("CoRider: Workers — %d batch(es) pending, %d in progress, %.0fs elapsed"),
+				CountFiles(GetPendingDir(QueueDir)), CountFiles(GetClaimedDir(QueueDir)), LastProgressLog - StartTime);
+		}
+
+		FPlatformProcess::Sleep(0.5f);
+	}
+
+	// Anything still pending ran out of crash relaunches
+	TArray<FString> Abandoned;
+	TArray<FString> LeftoverFiles;
+	FileManager.FindFiles(LeftoverFiles, *(GetPendingDir(QueueDir) / TEXT("*.txt")), true, false);
+	for (const FString& FileName : LeftoverFiles)
+	{
+		Abandoned.Append(ReadLines(GetPendingDir(QueueDir) / FileName));
+	}
+
+	// --- Merge per-worker results ---
+	struct FWorkerTotals
+	{
+		int32 Batches = 0;
+		int32 Extracted = 0;
+		int32 Written = 0;
+		int32 Failed = 0;
+		double Seconds = 0.0;
+	};
+	TArray<FWorkerTotals> Totals;
+	Totals.SetNum(NumWorkers);
+
+	TSet<FString> Failed;
+	TArray<FString> ResultFiles;
+	FileManager.FindFiles(ResultFiles, *(GetResultsDir(QueueDir) / TEXT("*.json")), true, false);
+	for (const FString& FileName : ResultFiles)
+	{
+		FString JsonString;
+		TSharedPtr<FJsonObject> WorkerJson;
+		if (!FFileHelper::LoadFileToString(JsonString, *(GetResultsDir(QueueDir) / FileName))
+			|| !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonString), WorkerJson)
+			|| !WorkerJson.IsValid())
+		{
+			continue;
+		}
+
+		const int32 WorkerId = WorkerJson->GetIntegerField(TEXT("WorkerId"));
+		if (!Totals.IsValidIndex(WorkerId))
+		{
+			continue;
+		}
+
+		FWorkerTotals& Worker = Totals[WorkerId];
+		Worker.Batches += WorkerJson->GetIntegerField(TEXT("Batches"));
+		Worker.Extracted += WorkerJson->GetIntegerField(TEXT("Extracted"));
+		Worker.Written += WorkerJson->GetIntegerField(TEXT("Written"));
+		Result.UnchangedCount += WorkerJson->GetIntegerField(TEXT("Unchanged"));
+		Worker.Seconds += WorkerJson->GetNumberField(TEXT("ElapsedSeconds"));
+		Result.GCCount += WorkerJson->GetIntegerField(TEXT("GCCount"));
+		Result.GCSeconds += WorkerJson->GetNumberField(TEXT("GCSeconds"));
+		for (const TSharedPtr<FJsonValue>& Value : WorkerJson->GetArrayField(TEXT("Failed")))
+		{
+			Failed.Add(Value->AsString());
+			++Worker.Failed;
+		}
+	}
+
+	Failed.Append(RecoveredFailed);
+	Failed.Append(Quarantined);
+	Failed.Append(Abandoned);
+
+	for (int32 WorkerId = 0; WorkerId < NumWorkers; ++WorkerId)
+	{
+		const FWorkerTotals& Worker = Totals[WorkerId];
+		Result.WrittenCount += Worker.Written;
+		Result.ExtractedCount += Worker.Extracted;
+
+		UE_LOG(LogCoRider, Display, TEXT("CoRider:   worker %2d — %d launch(es), %d crash(es), %d batch(es), %d written, %d failed, %.1f audits/s over %.1fs"),
+			WorkerId, Workers[WorkerId].Launches, Workers[WorkerId].Crashes, Worker.Batches, Worker.Written, Worker.Failed,
+			Worker.Seconds > 0.0 ? Worker.Extracted / Worker.Seconds : 0.0, Worker.Seconds);
+	}
+
+	Result.FailedPackages = Failed.Array();
+	Result.FailedPackages.Sort();
+	Result.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Workers complete — %d process(es), %d written, %d failed (%d quarantined, %d abandoned) in %.2fs wall-clock (%.1f audits/s)"),
+		NumWorkers, Result.WrittenCount, Result.FailedPackages.Num(), Quarantined.Num(), Abandoned.Num(), Result.ElapsedSeconds,
+		Result.ElapsedSeconds > 0.0 ? Result.ExtractedCount / Result.ElapsedSeconds : 0.0);
+
+	// Keep the queue (and worker logs) around for post-mortem only when something went wrong
+	const bool bAnyCrashed = Workers.ContainsByPredicate([](const FWorkerSlot& Slot) { return Slot.Crashes > 0; });
+	if (bAnyCrashed || Abandoned.Num() > 0)
+	{
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: Worker logs kept in %s"), *GetLogsDir(QueueDir));
+	}
+	else
+	{
+		FileManager.DeleteDirectory(*QueueDir, false, true);
+	}
+
+	return Result;
+}
+
+int32 FBlueprintAuditWorkers::RunWorker(const FString& QueueDir, int32 WorkerId, const FBlueprintAuditBatchOptions& InOptions)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// The parent forwards records from this file into its own stream once their packages are journaled done
+	FBlueprintAuditBatchOptions Options = InOptions;
+	if (!Options.StreamFormat.IsEmpty())
+	{
+		Options.Stream = FBlueprintAuditStream::Open(GetStreamDir(QueueDir) /
+			FString::Printf(TEXT("w%d-%u.ndjson"), WorkerId, FPlatformProcess::GetCurrentProcessId()), true);
+		if (!Options.Stream)
+		{
+			return 1;
+		}
+	}
+
+	int32 BatchCount = 0;
+	int32 ExtractedCount = 0;
+	int32 WrittenCount = 0;
+	int32 UnchangedCount = 0;
+	int32 GCCount = 0;
+	double GCSeconds = 0.0;
+	TArray<FString> FailedPackages;
+
+	// Rewritten after every batch, so the parent still gets this process's counts if it dies later
+	const FString ResultPath = GetResultsDir(QueueDir) / FString::Printf(TEXT("w%d-%u.json"), WorkerId, FPlatformProcess::GetCurrentProcessId());
+	auto WriteResults = [&]()
+	{
+		TArray<TSharedPtr<FJsonValue>> FailedArray;
+		for (const FString& PackageName : FailedPackages)
+		{
+			FailedArray.Add(MakeShareable(new FJsonValueString(PackageName)));
+		}
+
+		TSharedPtr<FJsonObject> WorkerJson = MakeShareable(new FJsonObject());
+		WorkerJson->SetNumberField(TEXT("WorkerId"), WorkerId);
+		WorkerJson->SetNumberField(TEXT("ProcessId"), FPlatformProcess::GetCurrentProcessId());
+		WorkerJson->SetNumberField(TEXT("Batches"), BatchCount);
+		WorkerJson->SetNumberField(TEXT("Extracted"), ExtractedCount);
+		WorkerJson->SetNumberField(TEXT("Written"), WrittenCount);
+		WorkerJson->SetNumberField(TEXT("Unchanged"), UnchangedCount);
+		WorkerJson->SetNumberField(TEXT("ElapsedSeconds"), FPlatformTime::Seconds() - StartTime);
+		WorkerJson->SetNumberField(TEXT("GCCount"), GCCount);
+		WorkerJson->SetNumberField(TEXT("GCSeconds"), GCSeconds);
+		WorkerJson->SetArrayField(TEXT("Failed"), FailedArray);
+		FBlueprintAuditor::WriteAuditJson(WorkerJson, ResultPath);
+	};
+
+	FString ClaimedPath;
+	while (ClaimNextBatch(QueueDir, WorkerId, ClaimedPath))
+	{
+		TArray<FBlueprintAuditWorkItem> WorkItems;
+		TArray<FString> MissingPackages;
+		FBlueprintAuditBatch::ResolveAssetList(ReadLines(ClaimedPath), WorkItems, MissingPackages);
+
+		// The journal lets the parent resume this batch after a crash, minus what already landed on disk
+		TUniquePtr<FBlueprintAuditCheckpoint> Progress = MakeUnique<FBlueprintAuditCheckpoint>(
+			GetProgressName(ClaimedPath), WorkItems, GetProgressDir(QueueDir));
+		Progress->Open(false);
+		for (const FString& PackageName : MissingPackages)
+		{
+			UE_LOG(LogCoRider, Warning, TEXT("CoRider: Worker %d — %s is no longer in the asset registry"), WorkerId, *PackageName);
+			Progress->MarkFailed(PackageName);
+		}
+		FailedPackages.Append(MissingPackages);
+
+		const FBlueprintAuditBatchResult BatchResult = FBlueprintAuditBatch::Run(WorkItems, Options, nullptr, Progress.Get());
+
+		++BatchCount;
+		ExtractedCount += BatchResult.ExtractedCount;
+		WrittenCount += BatchResult.WrittenCount;
+		UnchangedCount += BatchResult.UnchangedCount;
+		GCCount += BatchResult.GCCount;
+		GCSeconds += BatchResult.GCSeconds;
+		FailedPackages.Append(BatchResult.FailedPackages);
+
+		// Results and journal first: dying before the claim is released only makes the parent re-read a finished journal.
+		// The journal stays on disk for the parent to record.
+		WriteResults();
+		Progress.Reset();
+		IFileManager::Get().Delete(*ClaimedPath, false, false, true);
+	}
+
+	WriteResults();
+
+	UE_LOG(LogCoRider, Display, TEXT("CoRider: Worker %d finished — %d batch(es), %d written, %d failed in %.2fs"),
+		WorkerId, BatchCount, WrittenCount, FailedPackages.Num(), FPlatformTime::Seconds() - StartTime);
+	return 0;
+}
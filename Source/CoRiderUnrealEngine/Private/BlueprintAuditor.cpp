@@ -1,5 +1,8 @@
 #include "BlueprintAuditor.h"
 
+#include "BlueprintAuditData.h"
+#include "BlueprintAuditHashCache.h"
+#include "AssetRegistry/AssetRegistryModule.h"
 #include "Dom/JsonValue.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
@@ -13,61 +16,208 @@
 #include "K2Node_MacroInstance.h"
 #include "K2Node_VariableGet.h"
 #include "K2Node_VariableSet.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
 #include "Misc/FileHelper.h"
 #include "Misc/PackageName.h"
 #include "Misc/Paths.h"
+#include "Hash/xxhash.h"
 #include "Misc/SecureHash.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/CompactBinaryWriter.h"
+#include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
 #include "UObject/UnrealType.h"
 #include "WidgetBlueprint.h"
 #include "Blueprint/WidgetTree.h"
 #include "Components/Widget.h"
 #include "Components/PanelWidget.h"
 
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include "Windows/WindowsHWrapper.h"
+#include "Windows/HideWindowsPlatformTypes.h"
+#endif
+
 DEFINE_LOG_CATEGORY(LogCoRider);
 
-TSharedPtr<FJsonObject> FBlueprintAuditor::AuditBlueprint(const UBlueprint* BP)
+static TAutoConsoleVariable<bool> CVarAuditUseRegistryHash(
+	TEXT("CoRider.Audit.UseRegistryHash"),
+	true,
+	TEXT("Decide staleness from the asset registry's package saved hash when available, instead of hashing the .uasset."));
+
+static TAutoConsoleVariable<FString> CVarAuditHashAlgorithm(
+	TEXT("CoRider.Audit.HashAlgorithm"),
+	TEXT("md5"),
+	TEXT("Content hash for SourceFileHash: md5, or xxh64 (much faster, non-cryptographic)."));
+
+static TAutoConsoleVariable<bool> CVarAuditPrettyJson(
+	TEXT("CoRider.Audit.PrettyJson"),
+	false,
+	TEXT("Write indented audit JSON for debugging instead of compact single-line JSON."));
+
+static TAutoConsoleVariable<bool> CVarAuditCompactBinary(
+	TEXT("CoRider.Audit.CompactBinary"),
+	false,
+	TEXT("Also write each audit as Compact Binary (.ucb) next to its JSON, for consumers that would rather not parse text."));
+
+/** Accumulates a section fingerprint from in-memory state, without building any JSON. */
+struct FSectionFingerprint
+{
+	FXxHash64Builder Builder;
+
+	void Add(int64 Value) { Builder.Update(&Value, sizeof(Value)); }
+	void Add(FName Value) { Add(Value.GetDisplayIndex().ToUnstableInt()); Add(Value.GetNumber()); }
+	void Add(const FString& Value) { Builder.Update(*Value, Value.Len() * sizeof(TCHAR)); Add(Value.Len()); }
+	void Add(const UObject* Object) { Add(Object ? Object->GetFName() : NAME_None); Add(static_cast<int64>(reinterpret_cast<UPTRINT>(Object))); }
+
+	uint64 Get() const { return Builder.Finalize().Hash; }
+};
+
+/** Fingerprint everything AuditGraph reads from a graph. */
+static uint64 FingerprintGraph(const UEdGraph* Graph)
+{
+	FSectionFingerprint Fingerprint;
+	Fingerprint.Add(Graph->GetFName());
+	Fingerprint.Add(Graph->Nodes.Num());
+
+	for (const UEdGraphNode* Node : Graph->Nodes)
+	{
+		Fingerprint.Add(Node ? Node->GetClass() : nullptr);
+		if (const UK2Node_CustomEvent* CustomEvent = Cast<UK2Node_CustomEvent>(Node))
+		{
+			Fingerprint.Add(CustomEvent->CustomFunctionName);
+		}
+		else if (const UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+		{
+			// The title itself: bound events derive it from fields outside EventReference (component, owner)
+			Fingerprint.Add(EventNode->GetNodeTitle(ENodeTitleType::ListView).ToString());
+		}
+		else if (const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+		{
+			Fingerprint.Add(CallNode->FunctionReference.GetMemberName());
+			Fingerprint.Add(CallNode->GetTargetFunction());
+			for (const UEdGraphPin* Pin : CallNode->Pins)
+			{
+				Fingerprint.Add(Pin->PinName);
+				Fingerprint.Add(Pin->Direction);
+				Fingerprint.Add(Pin->PinType.PinCategory);
+				Fingerprint.Add(Pin->LinkedTo.Num());
+				Fingerprint.Add(Pin->DefaultValue);
+			}
+		}
+		else if (const UK2Node_VariableGet* GetNode = Cast<UK2Node_VariableGet>(Node))
+		{
+			Fingerprint.Add(GetNode->GetVarName());
+		}
+		else if (const UK2Node_VariableSet* SetNode = Cast<UK2Node_VariableSet>(Node))
+		{
+			Fingerprint.Add(SetNode->GetVarName());
+		}
+		else if (const UK2Node_MacroInstance* MacroNode = Cast<UK2Node_MacroInstance>(Node))
+		{
+			Fingerprint.Add(MacroNode->GetMacroGraph());
+		}
+	}
+	return Fingerprint.Get();
+}
+
+/** Fingerprint everything AuditWidget reads from a widget and its children. */
+static void FingerprintWidget(UWidget* Widget, FSectionFingerprint& Fingerprint)
+{
+	Fingerprint.Add(Widget);
+	if (!Widget)
+	{
+		return;
+	}
+	Fingerprint.Add(Widget->GetClass());
+	Fingerprint.Add(Widget->bIsVariable);
+
+	if (const UPanelWidget* Panel = Cast<UPanelWidget>(Widget))
+	{
+		Fingerprint.Add(Panel->GetChildrenCount());
+		for (int32 i = 0; i < Panel->GetChildrenCount(); ++i)
+		{
+			FingerprintWidget(Panel->GetChildAt(i), Fingerprint);
+		}
+	}
+}
+
+/** Audit a graph, reusing the cached audit when its fingerprint is unchanged. Records it in NewCache either way. */
+static FBlueprintAuditGraph AuditGraphSection(const FString& Key, const UEdGraph* Graph, FBlueprintAuditor::FSectionCache& Cache,
+	FBlueprintAuditor::FSectionCache& NewCache)
+{
+	const uint64 Fingerprint = FingerprintGraph(Graph);
+	const uint64* CachedFingerprint = Cache.Fingerprints.Find(Key);
+	FBlueprintAuditGraph* CachedGraph = Cache.Graphs.Find(Key);
+	NewCache.Fingerprints.Add(Key, Fingerprint);
+
+	if (CachedFingerprint && CachedGraph && *CachedFingerprint == Fingerprint)
+	{
+		++NewCache.ReusedCount;
+		FBlueprintAuditGraph Section = *CachedGraph;
+		NewCache.Graphs.Add(Key, MoveTemp(*CachedGraph));
+		return Section;
+	}
+
+	++NewCache.RecomputedCount;
+	FBlueprintAuditGraph Section = FBlueprintAuditor::AuditGraph(Graph);
+	NewCache.Graphs.Add(Key, Section);
+	return Section;
+}
+
+FBlueprintAuditData FBlueprintAuditor::AuditBlueprint(const UBlueprint* BP, bool bHashSourceFile, const FString& KnownSourceFileHash,
+	FSectionCache* SectionCache)
 {
-	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
+	// Sections of this audit; replaces SectionCache at the end so removed graphs drop out
+	FSectionCache NewCache;
+
+	FBlueprintAuditData Result;
 
 	// --- Metadata ---
-	Result->SetStringField(TEXT("Name"), BP->GetName());
-	Result->SetStringField(TEXT("Path"), BP->GetPathName());
-	Result->SetStringField(TEXT("ParentClass"),
-		BP->ParentClass ? BP->ParentClass->GetPathName() : TEXT("None"));
-	Result->SetStringField(TEXT("BlueprintType"),
-		StaticEnum<EBlueprintType>()->GetNameStringByValue(static_cast<int64>(BP->BlueprintType)));
+	Result.Name = BP->GetName();
+	Result.Path = BP->GetPathName();
+	Result.ParentClass = BP->ParentClass ? BP->ParentClass->GetPathName() : TEXT("None");
+	Result.BlueprintType = StaticEnum<EBlueprintType>()->GetNameStringByValue(static_cast<int64>(BP->BlueprintType));
 
 	// --- Source file hash (for stale detection) ---
-	const FString SourcePath = GetSourceFilePath(BP->GetOutermost()->GetName());
+	const FString PackageName = BP->GetOutermost()->GetName();
+	const FString SourcePath = GetSourceFilePath(PackageName);
 	if (!SourcePath.IsEmpty())
 	{
-		Result->SetStringField(TEXT("SourceFileHash"), ComputeFileHash(SourcePath));
+		Result.SourceFileHash = KnownSourceFileHash;
+		if (Result.SourceFileHash.IsEmpty() && bHashSourceFile)
+		{
+			Result.SourceFileHash = FBlueprintAuditHashCache::Get().GetFileHash(PackageName, SourcePath);
+		}
+		Result.SourceFileHashAlgorithm = GetSourceHashAlgorithm();
 	}
 
+	// The loaded package carries the saved hash of the bytes it came from; the registry reports the same value
+	const FIoHash SavedHash = BP->GetOutermost()->GetSavedHash();
+	Result.PackageSavedHash = SavedHash.IsZero() ? GetPackageSavedHash(PackageName) : LexToString(SavedHash);
+
 	UE_LOG(LogCoRider, Verbose, TEXT("CoRider: Auditing %s (Parent: %s)"),
 		*BP->GetName(), BP->ParentClass ? *BP->ParentClass->GetName() : TEXT("None"));
 
 	// --- Variables ---
-	TArray<TSharedPtr<FJsonValue>> VariablesArray;
+	Result.Variables.Reserve(BP->NewVariables.Num());
 	for (const FBPVariableDescription& Var : BP->NewVariables)
 	{
-		TSharedPtr<FJsonObject> VarObj = MakeShareable(new FJsonObject());
-		VarObj->SetStringField(TEXT("Name"), Var.VarName.ToString());
-		VarObj->SetStringField(TEXT("Type"), GetVariableTypeString(Var.VarType));
-		VarObj->SetStringField(TEXT("Category"), Var.Category.ToString());
-		VarObj->SetBoolField(TEXT("InstanceEditable"),
-			Var.HasMetaData(FBlueprintMetadata::MD_Private) == false &&
-			Var.PropertyFlags & CPF_Edit);
-		VarObj->SetBoolField(TEXT("Replicated"),
-			(Var.PropertyFlags & CPF_Net) != 0);
-		VariablesArray.Add(MakeShareable(new FJsonValueObject(VarObj)));
+		FBlueprintAuditVariable& VarAudit = Result.Variables.AddDefaulted_GetRef();
+		VarAudit.Name = Var.VarName;
+		VarAudit.Type = GetVariableTypeString(Var.VarType);
+		VarAudit.Category = Var.Category.ToString();
+		VarAudit.bInstanceEditable = Var.HasMetaData(FBlueprintMetadata::MD_Private) == false &&
+			Var.PropertyFlags & CPF_Edit;
+		VarAudit.bReplicated = (Var.PropertyFlags & CPF_Net) != 0;
 	}
-	Result->SetArrayField(TEXT("Variables"), VariablesArray);
 
 	// --- Property Overrides (CDO Diff) ---
-	TArray<TSharedPtr<FJsonValue>> OverridesArray;
 	if (UClass* GeneratedClass = BP->GeneratedClass)
 	{
 		if (UClass* SuperClass = GeneratedClass->GetSuperClass())
@@ -104,154 +254,157 @@ TSharedPtr<FJsonObject> FBlueprintAuditor::AuditBlueprint(const UBlueprint* BP)
 
 				if (!Prop->Identical(ValuePtr, SuperValuePtr))
 				{
-					TSharedPtr<FJsonObject> OverrideObj = MakeShareable(new FJsonObject());
-					OverrideObj->SetStringField(TEXT("Name"), Prop->GetName());
+					FBlueprintAuditPropertyOverride& Override = Result.PropertyOverrides.AddDefaulted_GetRef();
+					Override.Name = Prop->GetFName();
 
-					FString ValueStr;
 					// Use ExportText_InContainer to avoid manual value pointer handling issues
 					// Index 0, Container=CDO, Default=nullptr (force full export), Parent=nullptr, Flags=0
-					Prop->ExportText_InContainer(0, ValueStr, CDO, nullptr, nullptr, 0);
-					OverrideObj->SetStringField(TEXT("Value"), ValueStr);
-
-					OverridesArray.Add(MakeShareable(new FJsonValueObject(OverrideObj)));
+					Prop->ExportText_InContainer(0, Override.Value, CDO, nullptr, nullptr, 0);
 				}
 			}
 		}
 	}
-	Result->SetArrayField(TEXT("PropertyOverrides"), OverridesArray);
 
 	// --- Interfaces ---
-	TArray<TSharedPtr<FJsonValue>> InterfacesArray;
 	for (const FBPInterfaceDescription& Interface : BP->ImplementedInterfaces)
 	{
 		if (Interface.Interface)
 		{
-			InterfacesArray.Add(MakeShareable(new FJsonValueString(Interface.Interface->GetName())));
+			Result.Interfaces.Add(Interface.Interface->GetFName());
 		}
 	}
-	Result->SetArrayField(TEXT("Interfaces"), InterfacesArray);
 
 	// --- Components (Actor-based BPs) ---
-	TArray<TSharedPtr<FJsonValue>> ComponentsArray;
 	if (BP->SimpleConstructionScript)
 	{
 		for (const USCS_Node* Node : BP->SimpleConstructionScript->GetAllNodes())
 		{
 			if (Node && Node->ComponentClass)
 			{
-				TSharedPtr<FJsonObject> CompObj = MakeShareable(new FJsonObject());
-				CompObj->SetStringField(TEXT("Name"), Node->GetVariableName().ToString());
-				CompObj->SetStringField(TEXT("Class"), Node->ComponentClass->GetName());
-				ComponentsArray.Add(MakeShareable(new FJsonValueObject(CompObj)));
+				FBlueprintAuditComponent& Component = Result.Components.AddDefaulted_GetRef();
+				Component.Name = Node->GetVariableName();
+				Component.Class = Node->ComponentClass->GetFName();
 			}
 		}
 	}
-	Result->SetArrayField(TEXT("Components"), ComponentsArray);
 
 	// --- Timelines ---
-	TArray<TSharedPtr<FJsonValue>> TimelinesArray;
 	for (const UTimelineTemplate* Timeline : BP->Timelines)
 	{
 		if (!Timeline) continue;
 
-		TSharedPtr<FJsonObject> TLObj = MakeShareable(new FJsonObject());
-		TLObj->SetStringField(TEXT("Name"), Timeline->GetName());
-		TLObj->SetNumberField(TEXT("Length"), Timeline->TimelineLength);
-		TLObj->SetBoolField(TEXT("Looping"), Timeline->bLoop);
-		TLObj->SetBoolField(TEXT("AutoPlay"), Timeline->bAutoPlay);
-		TLObj->SetNumberField(TEXT("FloatTrackCount"), Timeline->FloatTracks.Num());
-		TLObj->SetNumberField(TEXT("VectorTrackCount"), Timeline->VectorTracks.Num());
-		TLObj->SetNumberField(TEXT("LinearColorTrackCount"), Timeline->LinearColorTracks.Num());
-		TLObj->SetNumberField(TEXT("EventTrackCount"), Timeline->EventTracks.Num());
-		TimelinesArray.Add(MakeShareable(new FJsonValueObject(TLObj)));
+		FBlueprintAuditTimeline& TimelineAudit = Result.Timelines.AddDefaulted_GetRef();
+		TimelineAudit.Name = Timeline->GetFName();
+		TimelineAudit.Length = Timeline->TimelineLength;
+		TimelineAudit.bLooping = Timeline->bLoop;
+		TimelineAudit.bAutoPlay = Timeline->bAutoPlay;
+		TimelineAudit.FloatTrackCount = Timeline->FloatTracks.Num();
+		TimelineAudit.VectorTrackCount = Timeline->VectorTracks.Num();
+		TimelineAudit.LinearColorTrackCount = Timeline->LinearColorTracks.Num();
+		TimelineAudit.EventTrackCount = Timeline->EventTracks.Num();
 	}
-	Result->SetArrayField(TEXT("Timelines"), TimelinesArray);
 
 	// --- Widget Tree (Widget Blueprints) ---
 	if (const UWidgetBlueprint* WidgetBP = Cast<UWidgetBlueprint>(BP))
 	{
 		if (WidgetBP->WidgetTree && WidgetBP->WidgetTree->RootWidget)
 		{
-			Result->SetObjectField(TEXT("WidgetTree"), AuditWidget(WidgetBP->WidgetTree->RootWidget));
+			UWidget* RootWidget = WidgetBP->WidgetTree->RootWidget;
+			if (!SectionCache)
+			{
+				Result.WidgetTree = AuditWidget(RootWidget);
+			}
+			else
+			{
+				FSectionFingerprint Fingerprint;
+				FingerprintWidget(RootWidget, Fingerprint);
+				const uint64* CachedFingerprint = SectionCache->Fingerprints.Find(TEXT("WidgetTree"));
+				if (CachedFingerprint && SectionCache->WidgetTree.IsSet() && *CachedFingerprint == Fingerprint.Get())
+				{
+					Result.WidgetTree = SectionCache->WidgetTree;
+					++NewCache.ReusedCount;
+				}
+				else
+				{
+					Result.WidgetTree = AuditWidget(RootWidget);
+					++NewCache.RecomputedCount;
+				}
+				NewCache.Fingerprints.Add(TEXT("WidgetTree"), Fingerprint.Get());
+				NewCache.WidgetTree = Result.WidgetTree;
+			}
 		}
 	}
 
 	// --- Event Graphs (UbergraphPages) ---
-	TArray<TSharedPtr<FJsonValue>> EventGraphs;
+	Result.EventGraphs.Reserve(BP->UbergraphPages.Num());
 	for (UEdGraph* Graph : BP->UbergraphPages)
 	{
-		EventGraphs.Add(MakeShareable(new FJsonValueObject(AuditGraph(Graph))));
+		Result.EventGraphs.Add(SectionCache
+			? AuditGraphSection(TEXT("EventGraphs/") + Graph->GetName(), Graph, *SectionCache, NewCache)
+			: AuditGraph(Graph));
 	}
-	Result->SetArrayField(TEXT("EventGraphs"), EventGraphs);
 
 	// --- Function Graphs ---
-	TArray<TSharedPtr<FJsonValue>> FunctionGraphs;
+	Result.FunctionGraphs.Reserve(BP->FunctionGraphs.Num());
 	for (UEdGraph* Graph : BP->FunctionGraphs)
 	{
-		FunctionGraphs.Add(MakeShareable(new FJsonValueObject(AuditGraph(Graph))));
+		Result.FunctionGraphs.Add(SectionCache
+			? AuditGraphSection(TEXT("FunctionGraphs/") + Graph->GetName(), Graph, *SectionCache, NewCache)
+			: AuditGraph(Graph));
 	}
-	Result->SetArrayField(TEXT("FunctionGraphs"), FunctionGraphs);
 
 	// --- Macro Graphs ---
-	TArray<TSharedPtr<FJsonValue>> MacroGraphs;
 	for (UEdGraph* Graph : BP->MacroGraphs)
 	{
-		TSharedPtr<FJsonObject> MacroObj = MakeShareable(new FJsonObject());
-		MacroObj->SetStringField(TEXT("Name"), Graph->GetName());
-		MacroObj->SetNumberField(TEXT("NodeCount"), Graph->Nodes.Num());
-		MacroGraphs.Add(MakeShareable(new FJsonValueObject(MacroObj)));
+		FBlueprintAuditMacroGraph& Macro = Result.MacroGraphs.AddDefaulted_GetRef();
+		Macro.Name = Graph->GetFName();
+		Macro.NodeCount = Graph->Nodes.Num();
 	}
-	Result->SetArrayField(TEXT("MacroGraphs"), MacroGraphs);
 
+	if (SectionCache)
+	{
+		*SectionCache = MoveTemp(NewCache);
+	}
 	return Result;
 }
 
-TSharedPtr<FJsonObject> FBlueprintAuditor::AuditGraph(const UEdGraph* Graph)
+FBlueprintAuditGraph FBlueprintAuditor::AuditGraph(const UEdGraph* Graph)
 {
-	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
-	Result->SetStringField(TEXT("Name"), Graph->GetName());
-	Result->SetNumberField(TEXT("TotalNodes"), Graph->Nodes.Num());
+	FBlueprintAuditGraph Result;
+	Result.Name = Graph->GetFName();
+	Result.TotalNodes = Graph->Nodes.Num();
 
-	TArray<TSharedPtr<FJsonValue>> Events;
-	TArray<TSharedPtr<FJsonValue>> FunctionCalls;
-	TSet<FString> VariablesRead;
-	TSet<FString> VariablesWritten;
-	TArray<TSharedPtr<FJsonValue>> Macros;
+	TSet<FName> VariablesRead;
+	TSet<FName> VariablesWritten;
 
 	for (UEdGraphNode* Node : Graph->Nodes)
 	{
 		// Check CustomEvent before Event (CustomEvent inherits from Event)
 		if (const UK2Node_CustomEvent* CustomEvent = Cast<UK2Node_CustomEvent>(Node))
 		{
-			Events.Add(MakeShareable(new FJsonValueString(
-				FString::Printf(TEXT("CustomEvent: %s"), *CustomEvent->CustomFunctionName.ToString()))));
+			Result.Events.Add(FString::Printf(TEXT("CustomEvent: %s"), *CustomEvent->CustomFunctionName.ToString()));
 		}
 		else if (const UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
 		{
-			Events.Add(MakeShareable(new FJsonValueString(
-				EventNode->GetNodeTitle(ENodeTitleType::ListView).ToString())));
+			Result.Events.Add(EventNode->GetNodeTitle(ENodeTitleType::ListView).ToString());
 		}
 		else if (const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
 		{
-			TSharedPtr<FJsonObject> CallObj = MakeShareable(new FJsonObject());
-			const FString FuncName = CallNode->FunctionReference.GetMemberName().ToString();
+			FBlueprintAuditFunctionCall& Call = Result.FunctionCalls.AddDefaulted_GetRef();
+			Call.Function = CallNode->FunctionReference.GetMemberName();
 
-			FString TargetClass = TEXT("Self");
+			Call.Target = TEXT("Self");
 			const UFunction* Func = CallNode->GetTargetFunction();
 			if (Func)
 			{
 				if (const UClass* OwnerClass = Func->GetOwnerClass())
 				{
-					TargetClass = OwnerClass->GetName();
+					Call.Target = OwnerClass->GetFName();
 				}
 			}
-
-			CallObj->SetStringField(TEXT("Function"), FuncName);
-			CallObj->SetStringField(TEXT("Target"), TargetClass);
-			CallObj->SetBoolField(TEXT("IsNative"), Func && Func->IsNative());
+			Call.bIsNative = Func && Func->IsNative();
 
 			// Capture hardcoded (literal) input pin values
-			TArray<TSharedPtr<FJsonValue>> DefaultInputs;
 			for (const UEdGraphPin* Pin : CallNode->Pins)
 			{
 				if (Pin->Direction != EGPD_Input) continue;
@@ -260,54 +413,30 @@ TSharedPtr<FJsonObject> FBlueprintAuditor::AuditGraph(const UEdGraph* Graph)
 				if (Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec) continue;
 				if (Pin->PinName == UEdGraphSchema_K2::PN_Self) continue;
 
-				TSharedPtr<FJsonObject> PinObj = MakeShareable(new FJsonObject());
-				PinObj->SetStringField(TEXT("Name"), Pin->PinName.ToString());
-				PinObj->SetStringField(TEXT("Value"), Pin->DefaultValue);
-				DefaultInputs.Add(MakeShareable(new FJsonValueObject(PinObj)));
+				Call.DefaultInputs.Add({Pin->PinName, Pin->DefaultValue});
 			}
-			if (DefaultInputs.Num() > 0)
-			{
-				CallObj->SetArrayField(TEXT("DefaultInputs"), DefaultInputs);
-			}
-
-			FunctionCalls.Add(MakeShareable(new FJsonValueObject(CallObj)));
 		}
 		else if (const UK2Node_VariableGet* GetNode = Cast<UK2Node_VariableGet>(Node))
 		{
-			VariablesRead.Add(GetNode->GetVarName().ToString());
+			VariablesRead.Add(GetNode->GetVarName());
 		}
 		else if (const UK2Node_VariableSet* SetNode = Cast<UK2Node_VariableSet>(Node))
 		{
-			VariablesWritten.Add(SetNode->GetVarName().ToString());
+			VariablesWritten.Add(SetNode->GetVarName());
 		}
 		else if (const UK2Node_MacroInstance* MacroNode = Cast<UK2Node_MacroInstance>(Node))
 		{
-			const FString MacroName = MacroNode->GetMacroGraph()
-				? MacroNode->GetMacroGraph()->GetName()
-				: TEXT("Unknown");
-			Macros.Add(MakeShareable(new FJsonValueString(MacroName)));
+			Result.MacroInstances.Add(MacroNode->GetMacroGraph()
+				? MacroNode->GetMacroGraph()->GetFName()
+				: FName(TEXT("Unknown")));
 		}
 	}
 
-	Result->SetArrayField(TEXT("Events"), Events);
-	Result->SetArrayField(TEXT("FunctionCalls"), FunctionCalls);
-
-	// Convert TSet to JSON arrays
-	TArray<TSharedPtr<FJsonValue>> VarsReadArr;
-	for (const FString& Var : VariablesRead)
-	{
-		VarsReadArr.Add(MakeShareable(new FJsonValueString(Var)));
-	}
-	Result->SetArrayField(TEXT("VariablesRead"), VarsReadArr);
-
-	TArray<TSharedPtr<FJsonValue>> VarsWrittenArr;
-	for (const FString& Var : VariablesWritten)
-	{
-		VarsWrittenArr.Add(MakeShareable(new FJsonValueString(Var)));
-	}
-	Result->SetArrayField(TEXT("VariablesWritten"), VarsWrittenArr);
-
-	Result->SetArrayField(TEXT("MacroInstances"), Macros);
+	// TSet iteration order isn't stable between runs; sorted output keeps unchanged graphs byte-identical
+	Result.VariablesRead = VariablesRead.Array();
+	Result.VariablesRead.Sort(FNameLexicalLess());
+	Result.VariablesWritten = VariablesWritten.Array();
+	Result.VariablesWritten.Sort(FNameLexicalLess());
 
 	return Result;
 }
@@ -355,10 +484,15 @@ FString FBlueprintAuditor::GetAuditOutputPath(const UBlueprint* BP)
 	return GetAuditOutputPath(BP->GetOutermost()->GetName());
 }
 
-FString FBlueprintAuditor::GetAuditBaseDir()
+FString FBlueprintAuditor::GetAuditVersionDir()
 {
 	const FString VersionDir = FString::Printf(TEXT("v%d"), AuditSchemaVersion);
-	return FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / TEXT("Saved") / TEXT("Audit") / VersionDir / TEXT("Blueprints"));
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / TEXT("Saved") / TEXT("Audit") / VersionDir);
+}
+
+FString FBlueprintAuditor::GetAuditBaseDir()
+{
+	return GetAuditVersionDir() / TEXT("Blueprints");
 }
 
 FString FBlueprintAuditor::GetAuditOutputPath(const FString& PackageName)
@@ -378,6 +512,14 @@ FString FBlueprintAuditor::GetAuditOutputPath(const FString& PackageName)
 bool FBlueprintAuditor::DeleteAuditJson(const FString& JsonPath)
 {
 	IFileManager& FM = IFileManager::Get();
+
+	// Quietly: the sibling only exists while Compact Binary output is (or was) on
+	const FString CompactBinaryPath = GetCompactBinaryPath(JsonPath);
+	if (CompactBinaryPath != JsonPath)
+	{
+		FM.Delete(*CompactBinaryPath, false, false, true);
+	}
+
 	if (!FM.FileExists(*JsonPath))
 	{
 		return true;
@@ -404,24 +546,727 @@ FString FBlueprintAuditor::GetSourceFilePath(const FString& PackageName)
 	return FString();
 }
 
+FString FBlueprintAuditor::GetSourceHashAlgorithm()
+{
+	const FString Algorithm = CVarAuditHashAlgorithm.GetValueOnAnyThread();
+	return Algorithm.Equals(TEXT("xxh64"), ESearchCase::IgnoreCase) ? TEXT("xxh64") : TEXT("md5");
+}
+
+/** Stream a file through XXH64. Returns empty string on failure. */
+static FString ComputeFileXxHash64(const FString& FilePath)
+{
+	const TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath, FILEREAD_Silent));
+	if (!Reader)
+	{
+		return FString();
+	}
+
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(1024 * 1024);
+	FXxHash64Builder Builder;
+	for (int64 Remaining = Reader->TotalSize(); Remaining > 0;)
+	{
+		const int64 ChunkSize = FMath::Min<int64>(Remaining, Buffer.Num());
+		Reader->Serialize(Buffer.GetData(), ChunkSize);
+		Builder.Update(Buffer.GetData(), ChunkSize);
+		Remaining -= ChunkSize;
+	}
+	if (!Reader->Close())
+	{
+		return FString();
+	}
+	return FString::Printf(TEXT("%016llx"), Builder.Finalize().Hash);
+}
+
 FString FBlueprintAuditor::ComputeFileHash(const FString& FilePath)
 {
-	const FMD5Hash Hash = FMD5Hash::HashFile(*FilePath);
-	if (Hash.IsValid())
+	FString Hash;
+	if (GetSourceHashAlgorithm() == TEXT("xxh64"))
 	{
-		return LexToString(Hash);
+		Hash = ComputeFileXxHash64(FilePath);
 	}
-	UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to compute hash for %s"), *FilePath);
-	return FString();
+	else
+	{
+		const FMD5Hash MD5 = FMD5Hash::HashFile(*FilePath);
+		if (MD5.IsValid())
+		{
+			Hash = LexToString(MD5);
+		}
+	}
+
+	if (Hash.IsEmpty())
+	{
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to compute hash for %s"), *FilePath);
+	}
+	return Hash;
 }
 
-bool FBlueprintAuditor::WriteAuditJson(const TSharedPtr<FJsonObject>& JsonObject, const FString& OutputPath)
+FString FBlueprintAuditor::GetPackageSavedHash(const FString& PackageName)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(FName(*PackageName));
+	if (!PackageData.IsSet() || PackageData->GetPackageSavedHash().IsZero())
+	{
+		return FString();
+	}
+	return LexToString(PackageData->GetPackageSavedHash());
+}
+
+/**
+ * Scan the leading scalar fields of an audit for the stored hashes, stopping at the first array or object
+ * (the audit body). Returns false if the text ran out before the body started, e.g. a truncated prefix.
+ */
+static bool ScanStoredHashes(const FString& JsonText, FBlueprintAuditor::FStoredHashes& OutStored)
+{
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+
+	EJsonNotation Notation;
+	if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+	{
+		return false;
+	}
+
+	while (Reader->ReadNext(Notation))
+	{
+		if (Notation == EJsonNotation::ArrayStart || Notation == EJsonNotation::ObjectStart || Notation == EJsonNotation::ObjectEnd)
+		{
+			return true;
+		}
+		if (Notation == EJsonNotation::String)
+		{
+			if (Reader->GetIdentifier() == TEXT("SourceFileHash"))
+			{
+				OutStored.SourceFileHash = Reader->GetValueAsString();
+			}
+			else if (Reader->GetIdentifier() == TEXT("SourceFileHashAlgorithm"))
+			{
+				OutStored.SourceFileHashAlgorithm = Reader->GetValueAsString();
+			}
+			else if (Reader->GetIdentifier() == TEXT("PackageSavedHash"))
+			{
+				OutStored.PackageSavedHash = Reader->GetValueAsString();
+			}
+		}
+	}
+	return false;
+}
+
+FBlueprintAuditor::FStoredHashes FBlueprintAuditor::ReadStoredHashes(const FString& JsonPath)
+{
+	FStoredHashes Stored;
+
+	// The hashes sit among the metadata fields ahead of the body, so a bounded prefix read normally finds them
+	// without loading or parsing the (possibly hundreds of KB) rest of the audit
+	constexpr int64 PrefixBytes = 4096;
+
+	const TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*JsonPath, FILEREAD_Silent));
+	if (!FileReader)
+	{
+		return Stored;
+	}
+
+	const int64 FileSize = FileReader->TotalSize();
+	TArray<uint8> Prefix;
+	Prefix.SetNumUninitialized(static_cast<int32>(FMath::Min(FileSize, PrefixBytes)));
+	FileReader->Serialize(Prefix.GetData(), Prefix.Num());
+	if (FileReader->Close() && Prefix.Num() > 0)
+	{
+		FString PrefixText;
+		FFileHelper::BufferToString(PrefixText, Prefix.GetData(), Prefix.Num());
+		if (ScanStoredHashes(PrefixText, Stored))
+		{
+			return Stored;
+		}
+	}
+
+	// Metadata longer than the prefix (or an unreadable one): fall back to a full parse
+	Stored = FStoredHashes();
+
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *JsonPath))
+	{
+		return Stored;
+	}
+
+	TSharedPtr<FJsonObject> ExistingJson;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(Reader, ExistingJson) || !ExistingJson.IsValid())
+	{
+		UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to parse existing audit JSON %s"), *JsonPath);
+		return Stored;
+	}
+
+	ExistingJson->TryGetStringField(TEXT("SourceFileHash"), Stored.SourceFileHash);
+	ExistingJson->TryGetStringField(TEXT("SourceFileHashAlgorithm"), Stored.SourceFileHashAlgorithm);
+	ExistingJson->TryGetStringField(TEXT("PackageSavedHash"), Stored.PackageSavedHash);
+	return Stored;
+}
+
+bool FBlueprintAuditor::IsAuditUpToDate(const FString& PackageName, const FString& SourcePath, const FString& JsonPath, FString* OutSourceFileHash)
+{
+	// Turning Compact Binary output on makes every audit without it stale, so the next pass fills it in
+	if (IsCompactBinaryEnabled() && !IFileManager::Get().FileExists(*GetCompactBinaryPath(JsonPath)))
+	{
+		return false;
+	}
+
+	const FStoredHashes Stored = ReadStoredHashes(JsonPath);
+	if (Stored.SourceFileHash.IsEmpty() && Stored.PackageSavedHash.IsEmpty())
+	{
+		return false;
+	}
+
+	if (CVarAuditUseRegistryHash.GetValueOnAnyThread() && !Stored.PackageSavedHash.IsEmpty())
+	{
+		const FString SavedHash = GetPackageSavedHash(PackageName);
+		if (!SavedHash.IsEmpty())
+		{
+			return SavedHash == Stored.PackageSavedHash;
+		}
+	}
+
+	// No registry data (or an audit written before PackageSavedHash existed): hash the file.
+	// Audits from before SourceFileHashAlgorithm existed were always MD5.
+	const FString StoredAlgorithm = Stored.SourceFileHashAlgorithm.IsEmpty() ? FString(TEXT("md5")) : Stored.SourceFileHashAlgorithm;
+	if (StoredAlgorithm != GetSourceHashAlgorithm())
+	{
+		return false;
+	}
+
+	const FString CurrentHash = FBlueprintAuditHashCache::Get().GetFileHash(PackageName, SourcePath);
+	if (OutSourceFileHash)
+	{
+		*OutSourceFileHash = CurrentHash;
+	}
+	return !CurrentHash.IsEmpty() && CurrentHash == Stored.SourceFileHash;
+}
+
+int32 FBlueprintAuditor::SweepOrphanedAuditFiles(int64* OutBytesReclaimed)
+{
+	const FString BaseDir = GetAuditBaseDir();
+	if (!IFileManager::Get().DirectoryExists(*BaseDir))
+	{
+		return 0;
+	}
+
+	// An audit written after this instant may belong to a Blueprint the snapshot below doesn't know yet
+	// (created and saved while we walk the tree); the margin covers coarse file-time resolution
+	const FDateTime SnapshotTime = FDateTime::UtcNow() - FTimespan::FromSeconds(2.0);
+
+	// One registry query for every live project Blueprint, instead of one lookup per audit file
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	TArray<FAssetData> Blueprints;
+	AssetRegistry.GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), Blueprints, true);
+
+	TSet<FString> LivePackages;
+	LivePackages.Reserve(Blueprints.Num());
+	for (const FAssetData& Asset : Blueprints)
+	{
+		FString PackageName = Asset.PackageName.ToString();
+		if (PackageName.StartsWith(TEXT("/Game/")))
+		{
+			LivePackages.Add(MoveTemp(PackageName));
+		}
+	}
+
+	// Diff the audit tree against the set: <BaseDir>/UI/WBP_Foo.json (or .ucb) <-> /Game/UI/WBP_Foo
+	// Temp files from interrupted writes go too, once they are old enough not to belong to a write in progress
+	const FDateTime StaleTempTime = FDateTime::UtcNow() - FTimespan::FromHours(1.0);
+	TArray<FString> OrphanFiles;
+	int64 OrphanBytes = 0;
+	IFileManager::Get().IterateDirectoryStatRecursively(*BaseDir,
+		[&BaseDir, &LivePackages, &OrphanFiles, &OrphanBytes, &StaleTempTime, &SnapshotTime](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+		{
+			const FStringView Filename(FilenameOrDirectory);
+			if (StatData.bIsDirectory || !Filename.StartsWith(BaseDir))
+			{
+				return true;
+			}
+			if (Filename.EndsWith(TempFileSuffix))
+			{
+				if (StatData.ModificationTime < StaleTempTime)
+				{
+					OrphanFiles.Emplace(Filename);
+					OrphanBytes += FMath::Max<int64>(StatData.FileSize, 0);
+				}
+				return true;
+			}
+			const int32 ExtensionLen = Filename.EndsWith(TEXT(".json")) ? 5 : Filename.EndsWith(TEXT(".ucb")) ? 4 : 0;
+			if (ExtensionLen == 0)
+			{
+				return true;
+			}
+
+			FString RelPath(Filename.Mid(BaseDir.Len(), Filename.Len() - BaseDir.Len() - ExtensionLen));
+			RelPath.ReplaceInline(TEXT("\\"), TEXT("/"));
+			RelPath.RemoveFromStart(TEXT("/"));
+
+			if (!LivePackages.Contains(TEXT("/Game/") + RelPath) && StatData.ModificationTime < SnapshotTime)
+			{
+				OrphanFiles.Emplace(Filename);
+				OrphanBytes += FMath::Max<int64>(StatData.FileSize, 0);
+			}
+			return true;
+		});
+
+	for (const FString& OrphanFile : OrphanFiles)
+	{
+		DeleteAuditJson(OrphanFile);
+	}
+
+	if (OrphanFiles.Num() > 0)
+	{
+		UE_LOG(LogCoRider, Display, TEXT("CoRider: Swept %d orphaned audit file(s), %.1f MB reclaimed"),
+			OrphanFiles.Num(), OrphanBytes / (1024.0 * 1024.0));
+	}
+	if (OutBytesReclaimed)
+	{
+		*OutBytesReclaimed = OrphanBytes;
+	}
+	return OrphanFiles.Num();
+}
+
+int32 FBlueprintAuditor::DeleteOldAuditVersions(int64* OutBytesReclaimed)
+{
+	const FString AuditRoot = FPaths::GetPath(GetAuditVersionDir());
+
+	TArray<FString> VersionDirs;
+	IFileManager::Get().FindFiles(VersionDirs, *(AuditRoot / TEXT("v*")), false, true);
+
+	int32 DeletedCount = 0;
+	int64 DeletedBytes = 0;
+	for (const FString& VersionDir : VersionDirs)
+	{
+		// Only older schemas: a newer one belongs to another checkout of the plugin sharing this project
+		const FString VersionString = VersionDir.RightChop(1);
+		if (!VersionString.IsNumeric() || FCString::Atoi(*VersionString) >= AuditSchemaVersion)
+		{
+			continue;
+		}
+
+		const FString DirPath = AuditRoot / VersionDir;
+		int64 DirBytes = 0;
+		IFileManager::Get().IterateDirectoryStatRecursively(*DirPath, [&DirBytes](const TCHAR*, const FFileStatData& StatData)
+		{
+			if (!StatData.bIsDirectory)
+			{
+				DirBytes += FMath::Max<int64>(StatData.FileSize, 0);
+			}
+			return true;
+		});
+
+		if (IFileManager::Get().DeleteDirectory(*DirPath, false, true))
+		{
+			UE_LOG(LogCoRider, Display, TEXT("CoRider: Deleted old audit schema directory %s — %.1f MB reclaimed"),
+				*DirPath, DirBytes / (1024.0 * 1024.0));
+			++DeletedCount;
+			DeletedBytes += DirBytes;
+		}
+		else
+		{
+			UE_LOG(LogCoRider, Warning, TEXT("CoRider: Failed to delete old audit schema directory %s"), *DirPath);
+		}
+	}
+
+	if (OutBytesReclaimed)
+	{
+		*OutBytesReclaimed = DeletedBytes;
+	}
+	return DeletedCount;
+}
+
+FString FBlueprintAuditor::SerializeAuditJson(const TSharedPtr<FJsonObject>& JsonObject, bool bCondensed)
 {
 	FString OutputString;
-	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+	if (bCondensed)
+	{
+		const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutputString);
+		FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+	}
+	else
+	{
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+		FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+	}
+	return OutputString;
+}
+
+template <typename WriterType>
+static void WriteNameArray(WriterType& Writer, const TCHAR* Identifier, const TArray<FName>& Names)
+{
+	Writer.WriteArrayStart(Identifier);
+	for (const FName Name : Names)
+	{
+		Writer.WriteValue(Name.ToString());
+	}
+	Writer.WriteArrayEnd();
+}
+
+template <typename WriterType>
+static void WriteAuditWidget(WriterType& Writer, const FBlueprintAuditWidget& Widget)
+{
+	Writer.WriteValue(TEXT("Name"), Widget.Name.ToString());
+	Writer.WriteValue(TEXT("Class"), Widget.Class.ToString());
+	Writer.WriteValue(TEXT("IsVariable"), Widget.bIsVariable);
+	if (Widget.bIsPanel)
+	{
+		Writer.WriteArrayStart(TEXT("Children"));
+		for (const FBlueprintAuditWidget& Child : Widget.Children)
+		{
+			Writer.WriteObjectStart();
+			WriteAuditWidget(Writer, Child);
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteArrayEnd();
+	}
+}
+
+template <typename WriterType>
+static void WriteAuditGraphs(WriterType& Writer, const TCHAR* Identifier, const TArray<FBlueprintAuditGraph>& Graphs)
+{
+	Writer.WriteArrayStart(Identifier);
+	for (const FBlueprintAuditGraph& Graph : Graphs)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("Name"), Graph.Name.ToString());
+		Writer.WriteValue(TEXT("TotalNodes"), Graph.TotalNodes);
+
+		Writer.WriteArrayStart(TEXT("Events"));
+		for (const FString& Event : Graph.Events)
+		{
+			Writer.WriteValue(Event);
+		}
+		Writer.WriteArrayEnd();
+
+		Writer.WriteArrayStart(TEXT("FunctionCalls"));
+		for (const FBlueprintAuditFunctionCall& Call : Graph.FunctionCalls)
+		{
+			Writer.WriteObjectStart();
+			Writer.WriteValue(TEXT("Function"), Call.Function.ToString());
+			Writer.WriteValue(TEXT("Target"), Call.Target.ToString());
+			Writer.WriteValue(TEXT("IsNative"), Call.bIsNative);
+			if (Call.DefaultInputs.Num() > 0)
+			{
+				Writer.WriteArrayStart(TEXT("DefaultInputs"));
+				for (const FBlueprintAuditPinDefault& Pin : Call.DefaultInputs)
+				{
+					Writer.WriteObjectStart();
+					Writer.WriteValue(TEXT("Name"), Pin.Name.ToString());
+					Writer.WriteValue(TEXT("Value"), Pin.Value);
+					Writer.WriteObjectEnd();
+				}
+				Writer.WriteArrayEnd();
+			}
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteArrayEnd();
+
+		WriteNameArray(Writer, TEXT("VariablesRead"), Graph.VariablesRead);
+		WriteNameArray(Writer, TEXT("VariablesWritten"), Graph.VariablesWritten);
+		WriteNameArray(Writer, TEXT("MacroInstances"), Graph.MacroInstances);
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+}
+
+/** Write an audit as one JSON object, in schema field order. */
+template <typename WriterType>
+static void WriteAuditObject(WriterType& Writer, const FBlueprintAuditData& Audit)
+{
+	Writer.WriteObjectStart();
+
+	// --- Metadata ---
+	Writer.WriteValue(TEXT("Name"), Audit.Name);
+	Writer.WriteValue(TEXT("Path"), Audit.Path);
+	Writer.WriteValue(TEXT("ParentClass"), Audit.ParentClass);
+	Writer.WriteValue(TEXT("BlueprintType"), Audit.BlueprintType);
+
+	// Keep the hashes among the leading scalar fields: ReadStoredHashes only reads a prefix up to the first array
+	if (!Audit.SourceFileHashAlgorithm.IsEmpty())
+	{
+		Writer.WriteValue(TEXT("SourceFileHash"), Audit.SourceFileHash);
+		Writer.WriteValue(TEXT("SourceFileHashAlgorithm"), Audit.SourceFileHashAlgorithm);
+	}
+	if (!Audit.PackageSavedHash.IsEmpty())
+	{
+		Writer.WriteValue(TEXT("PackageSavedHash"), Audit.PackageSavedHash);
+	}
+
+	// --- Variables ---
+	Writer.WriteArrayStart(TEXT("Variables"));
+	for (const FBlueprintAuditVariable& Var : Audit.Variables)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("Name"), Var.Name.ToString());
+		Writer.WriteValue(TEXT("Type"), Var.Type);
+		Writer.WriteValue(TEXT("Category"), Var.Category);
+		Writer.WriteValue(TEXT("InstanceEditable"), Var.bInstanceEditable);
+		Writer.WriteValue(TEXT("Replicated"), Var.bReplicated);
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+
+	// --- Property Overrides ---
+	Writer.WriteArrayStart(TEXT("PropertyOverrides"));
+	for (const FBlueprintAuditPropertyOverride& Override : Audit.PropertyOverrides)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("Name"), Override.Name.ToString());
+		Writer.WriteValue(TEXT("Value"), Override.Value);
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+
+	WriteNameArray(Writer, TEXT("Interfaces"), Audit.Interfaces);
 
-	if (FFileHelper::SaveStringToFile(OutputString, *OutputPath))
+	// --- Components ---
+	Writer.WriteArrayStart(TEXT("Components"));
+	for (const FBlueprintAuditComponent& Component : Audit.Components)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("Name"), Component.Name.ToString());
+		Writer.WriteValue(TEXT("Class"), Component.Class.ToString());
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+
+	// --- Timelines ---
+	Writer.WriteArrayStart(TEXT("Timelines"));
+	for (const FBlueprintAuditTimeline& Timeline : Audit.Timelines)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("Name"), Timeline.Name.ToString());
+		Writer.WriteValue(TEXT("Length"), static_cast<double>(Timeline.Length));
+		Writer.WriteValue(TEXT("Looping"), Timeline.bLooping);
+		Writer.WriteValue(TEXT("AutoPlay"), Timeline.bAutoPlay);
+		Writer.WriteValue(TEXT("FloatTrackCount"), Timeline.FloatTrackCount);
+		Writer.WriteValue(TEXT("VectorTrackCount"), Timeline.VectorTrackCount);
+		Writer.WriteValue(TEXT("LinearColorTrackCount"), Timeline.LinearColorTrackCount);
+		Writer.WriteValue(TEXT("EventTrackCount"), Timeline.EventTrackCount);
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+
+	// --- Widget Tree ---
+	if (Audit.WidgetTree.IsSet())
+	{
+		Writer.WriteObjectStart(TEXT("WidgetTree"));
+		WriteAuditWidget(Writer, Audit.WidgetTree.GetValue());
+		Writer.WriteObjectEnd();
+	}
+
+	// --- Graphs ---
+	WriteAuditGraphs(Writer, TEXT("EventGraphs"), Audit.EventGraphs);
+	WriteAuditGraphs(Writer, TEXT("FunctionGraphs"), Audit.FunctionGraphs);
+
+	Writer.WriteArrayStart(TEXT("MacroGraphs"));
+	for (const FBlueprintAuditMacroGraph& Macro : Audit.MacroGraphs)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("Name"), Macro.Name.ToString());
+		Writer.WriteValue(TEXT("NodeCount"), Macro.NodeCount);
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteObjectEnd();
+}
+
+/**
+ * Drives an FCbWriter through the TJsonWriter calls WriteAuditObject makes, so both encodings share one
+ * field list. Compact Binary names and strings are UTF-8; numbers keep their type rather than becoming text.
+ */
+class FCbAuditWriter
+{
+public:
+	explicit FCbAuditWriter(FCbWriter& InWriter)
+		: Writer(InWriter)
+	{
+	}
+
+	void WriteObjectStart() { Writer.BeginObject(); }
+	void WriteObjectStart(const TCHAR* Identifier) { Writer.BeginObject(FUtf8(Identifier)); }
+	void WriteObjectEnd() { Writer.EndObject(); }
+	void WriteArrayStart(const TCHAR* Identifier) { Writer.BeginArray(FUtf8(Identifier)); }
+	void WriteArrayEnd() { Writer.EndArray(); }
+
+	void WriteValue(const FString& Value) { Writer.AddString(FUtf8(*Value)); }
+	void WriteValue(const TCHAR* Identifier, const FString& Value) { Writer.AddString(FUtf8(Identifier), FUtf8(*Value)); }
+	void WriteValue(const TCHAR* Identifier, bool bValue) { Writer.AddBool(FUtf8(Identifier), bValue); }
+	void WriteValue(const TCHAR* Identifier, int32 Value) { Writer.AddInteger(FUtf8(Identifier), Value); }
+	void WriteValue(const TCHAR* Identifier, double Value) { Writer.AddFloat(FUtf8(Identifier), Value); }
+
+private:
+	/** Converts for the duration of one call. */
+	struct FUtf8
+	{
+		explicit FUtf8(const TCHAR* Value) : Converted(Value) {}
+		operator FUtf8StringView() const { return FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Converted.Get()), Converted.Length()); }
+
+		FTCHARToUTF8 Converted;
+	};
+
+	FCbWriter& Writer;
+};
+
+/** True if the file at Path holds exactly Bytes. Only reads the file when the sizes match. */
+static bool IsFileContentEqual(const FString& Path, const TArray<uint8>& Bytes)
+{
+	if (IFileManager::Get().FileSize(*Path) != Bytes.Num())
+	{
+		return false;
+	}
+
+	TArray<uint8> Existing;
+	return FFileHelper::LoadFileToArray(Existing, *Path, FILEREAD_Silent) && Existing == Bytes;
+}
+
+FString FBlueprintAuditor::MakeTempFilePath(const FString& Path)
+{
+	return FString::Printf(TEXT("%s.%u-%u%s"), *Path, FPlatformProcess::GetCurrentProcessId(), FPlatformTLS::GetCurrentThreadId(), TempFileSuffix);
+}
+
+bool FBlueprintAuditor::ReplaceFile(const FString& DestPath, const FString& SourcePath)
+{
+#if PLATFORM_WINDOWS
+	const FString FullSource = FPaths::ConvertRelativePathToFull(SourcePath);
+	const FString FullDest = FPaths::ConvertRelativePathToFull(DestPath);
+	return MoveFileExW(*FullSource, *FullDest, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+	// rename() replaces an existing destination atomically
+	return FPlatformFileManager::Get().GetPlatformFile().MoveFile(*DestPath, *SourcePath);
+#endif
+}
+
+/**
+ * Write Bytes to a sibling temp file, then swap it over Path, so readers never see a half-written or missing audit.
+ * The temp name is unique to this process and thread, so the editor and a commandlet can write the same audit at once.
+ * A temp file left by a crash is removed by SweepOrphanedAuditFiles.
+ */
+static bool SaveFileAtomically(const TArray<uint8>& Bytes, const FString& Path)
+{
+	const FString TempPath = FBlueprintAuditor::MakeTempFilePath(Path);
+	if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath))
+	{
+		return false;
+	}
+	if (!FBlueprintAuditor::ReplaceFile(Path, TempPath))
+	{
+		IFileManager::Get().Delete(*TempPath, false, true, true);
+		return false;
+	}
+	return true;
+}
+
+/** Write Bytes to Path unless it already holds them. Adds to InOutBytesWritten only when the file was written. */
+static bool WriteFileIfChanged(const TArray<uint8>& Bytes, const FString& Path, int64& InOutBytesWritten, bool& bOutUnchanged)
+{
+	bOutUnchanged = IsFileContentEqual(Path, Bytes);
+	if (bOutUnchanged)
+	{
+		// Leave the mtime alone so Rider's file watchers and VCS status don't see a change
+		UE_LOG(LogCoRider, Verbose, TEXT("CoRider: Audit unchanged, not rewritten — %s"), *Path);
+		return true;
+	}
+
+	if (!SaveFileAtomically(Bytes, Path))
+	{
+		UE_LOG(LogCoRider, Error, TEXT("CoRider: Failed to write %s"), *Path);
+		return false;
+	}
+
+	InOutBytesWritten += Bytes.Num();
+	UE_LOG(LogCoRider, Verbose, TEXT("CoRider: Audit saved to %s"), *Path);
+	return true;
+}
+
+bool FBlueprintAuditor::IsPrettyJson()
+{
+	return CVarAuditPrettyJson.GetValueOnAnyThread();
+}
+
+bool FBlueprintAuditor::IsCompactBinaryEnabled()
+{
+	return CVarAuditCompactBinary.GetValueOnAnyThread();
+}
+
+FString FBlueprintAuditor::GetCompactBinaryPath(const FString& JsonPath)
+{
+	return JsonPath.EndsWith(TEXT(".json")) ? JsonPath.LeftChop(5) + TEXT(".ucb") : JsonPath;
+}
+
+void FBlueprintAuditor::SerializeAuditCompactBinary(const FBlueprintAuditData& Audit, FArchive& Ar)
+{
+	FCbWriter Writer;
+	FCbAuditWriter AuditWriter(Writer);
+	WriteAuditObject(AuditWriter, Audit);
+	Writer.Save(Ar);
+}
+
+void FBlueprintAuditor::SerializeAuditJson(const FBlueprintAuditData& Audit, FArchive& Ar, bool bPretty)
+{
+	if (bPretty)
+	{
+		const TSharedRef<TJsonWriter<UTF8CHAR, TPrettyJsonPrintPolicy<UTF8CHAR>>> Writer =
+			TJsonWriterFactory<UTF8CHAR, TPrettyJsonPrintPolicy<UTF8CHAR>>::Create(&Ar);
+		WriteAuditObject(*Writer, Audit);
+		Writer->Close();
+	}
+	else
+	{
+		const TSharedRef<TJsonWriter<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>> Writer =
+			TJsonWriterFactory<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>::Create(&Ar);
+		WriteAuditObject(*Writer, Audit);
+		Writer->Close();
+	}
+}
+
+bool FBlueprintAuditor::WriteAuditJson(const FBlueprintAuditData& Audit, const FString& OutputPath, int64* OutBytesWritten, bool* bOutUnchanged)
+{
+	// Serialized up front so it can be compared with the file on disk; compact UTF-8 keeps the buffer small
+	TArray<uint8> Bytes;
+	FMemoryWriter BytesWriter(Bytes);
+	SerializeAuditJson(Audit, BytesWriter, IsPrettyJson());
+
+	int64 BytesWritten = 0;
+	bool bJsonUnchanged = false;
+	bool bWritten = WriteFileIfChanged(Bytes, OutputPath, BytesWritten, bJsonUnchanged);
+
+	const FString CompactBinaryPath = GetCompactBinaryPath(OutputPath);
+	bool bCompactBinaryUnchanged = true;
+	if (IsCompactBinaryEnabled())
+	{
+		TArray<uint8> CompactBinary;
+		FMemoryWriter CompactBinaryWriter(CompactBinary);
+		SerializeAuditCompactBinary(Audit, CompactBinaryWriter);
+		bWritten &= WriteFileIfChanged(CompactBinary, CompactBinaryPath, BytesWritten, bCompactBinaryUnchanged);
+	}
+	else if (!bJsonUnchanged && CompactBinaryPath != OutputPath)
+	{
+		// A sibling from when the setting was on would now describe an older audit
+		IFileManager::Get().Delete(*CompactBinaryPath, false, false, true);
+	}
+
+	if (OutBytesWritten)
+	{
+		*OutBytesWritten = BytesWritten;
+	}
+	if (bOutUnchanged)
+	{
+		*bOutUnchanged = bJsonUnchanged && bCompactBinaryUnchanged;
+	}
+	return bWritten;
+}
+
+bool FBlueprintAuditor::WriteAuditJson(const TSharedPtr<FJsonObject>& JsonObject, const FString& OutputPath)
+{
+	return SaveAuditString(SerializeAuditJson(JsonObject), OutputPath);
+}
+
+bool FBlueprintAuditor::SaveAuditString(const FString& JsonString, const FString& OutputPath)
+{
+	if (FFileHelper::SaveStringToFile(JsonString, *OutputPath))
 	{
 		UE_LOG(LogCoRider, Verbose, TEXT("CoRider: Audit saved to %s"), *OutputPath);
 		return true;
@@ -431,29 +1276,29 @@ bool FBlueprintAuditor::WriteAuditJson(const TSharedPtr<FJsonObject>& JsonObject
 	return false;
 }
 
-TSharedPtr<FJsonObject> FBlueprintAuditor::AuditWidget(UWidget* Widget)
+FBlueprintAuditWidget FBlueprintAuditor::AuditWidget(UWidget* Widget)
 {
-	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
+	FBlueprintAuditWidget Result;
 	if (!Widget)
 	{
 		return Result;
 	}
 
-	Result->SetStringField(TEXT("Name"), Widget->GetName());
-	Result->SetStringField(TEXT("Class"), Widget->GetClass()->GetName());
-	Result->SetBoolField(TEXT("IsVariable"), Widget->bIsVariable);
+	Result.Name = Widget->GetFName();
+	Result.Class = Widget->GetClass()->GetFName();
+	Result.bIsVariable = Widget->bIsVariable;
 
 	if (UPanelWidget* Panel = Cast<UPanelWidget>(Widget))
 	{
-		TArray<TSharedPtr<FJsonValue>> ChildrenArray;
+		Result.bIsPanel = true;
+		Result.Children.Reserve(Panel->GetChildrenCount());
 		for (int32 i = 0; i < Panel->GetChildrenCount(); ++i)
 		{
 			if (UWidget* Child = Panel->GetChildAt(i))
 			{
-				ChildrenArray.Add(MakeShareable(new FJsonValueObject(AuditWidget(Child))));
+				Result.Children.Add(AuditWidget(Child));
 			}
 		}
-		Result->SetArrayField(TEXT("Children"), ChildrenArray);
 	}
 
 	return Result;
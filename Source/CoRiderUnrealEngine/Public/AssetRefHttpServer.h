@@ -1,21 +1,31 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HttpPath.h"
+#include "HttpRequestHandler.h"
 #include "HttpRouteHandle.h"
+#include "HttpServerConstants.h"
 
 class IHttpRouter;
 
 /**
- * Lightweight HTTP server exposing IAssetRegistry dependency/referencer queries.
- * Binds to a dynamic port (19877-19887) and writes a marker file so the Rider
- * plugin can discover it.
+ * Lightweight HTTP server exposing IAssetRegistry dependency/referencer queries,
+ * and GET /audit/blueprint?package=... for a Blueprint's audit as JSON or Compact
+ * Binary, picked by the request's Accept header.
+ * Binds to a dynamic port (19900-19910) and writes a marker file so the Rider
+ * plugin can discover it. Other features can hang extra routes off the same
+ * server with AddRoute().
  */
 class CORIDERUNREALENGINE_API FAssetRefHttpServer
 {
 public:
-	FAssetRefHttpServer();
+	/** @param InMarkerFileName  Marker file under Saved/; separate processes must use different names. */
+	explicit FAssetRefHttpServer(const FString& InMarkerFileName = TEXT(".corider-ue-server.json"));
 	~FAssetRefHttpServer();
 
+	/** Register an additional route. Call before Start(). */
+	void AddRoute(const FHttpPath& Path, EHttpServerRequestVerbs Verbs, const FHttpRequestHandler& Handler);
+
 	/** Bind to a port, register routes, write marker file. */
 	bool Start();
 
@@ -29,23 +39,36 @@ private:
 	/** Try to bind the HTTP module router on the given port. */
 	bool TryBind(int32 Port);
 
-	/** Write Saved/.corider-ue-server.json with port, PID, and timestamp. */
+	/** Write the marker file (Saved/.corider-ue-server.json by default) with port, PID, and timestamp. */
 	void WriteMarkerFile() const;
 
-	/** Delete Saved/.corider-ue-server.json if it exists. */
+	/** Delete the marker file if it exists. */
 	void DeleteMarkerFile() const;
 
 	/** Return the full path to the marker file. */
-	static FString GetMarkerFilePath();
+	FString GetMarkerFilePath() const;
 
 	// Route handlers
 	bool HandleHealth(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
 	bool HandleDependencies(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
 	bool HandleReferencers(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
 
+	/** Serve a Blueprint's audit file from disk in the format the Accept header prefers. */
+	bool HandleBlueprintAudit(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
 	/** Shared logic for dependencies/referencers. bGetDependencies=true for deps, false for referencers. */
 	bool HandleAssetQuery(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete, bool bGetDependencies);
 
+	struct FExtraRoute
+	{
+		FHttpPath Path;
+		EHttpServerRequestVerbs Verbs;
+		FHttpRequestHandler Handler;
+	};
+
+	FString MarkerFileName;
+	TArray<FExtraRoute> ExtraRoutes;
+
 	int32 BoundPort = 0;
 	TSharedPtr<IHttpRouter> HttpRouter;
 	TArray<FHttpRouteHandle> RouteHandles;
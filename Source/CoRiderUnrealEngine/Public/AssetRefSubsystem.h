@@ -8,6 +8,9 @@
 /**
  * Editor subsystem that owns the asset reference HTTP server.
  * Starts the server on editor launch and stops it on shutdown.
+ *
+ * Also serves POST /audit/requests {"packages": [...]}, which checks the listed Blueprints and
+ * moves stale ones to the front of UBlueprintAuditSubsystem's background queue.
  */
 UCLASS()
 class CORIDERUNREALENGINE_API UAssetRefSubsystem : public UEditorSubsystem
@@ -19,5 +22,8 @@ public:
 	virtual void Deinitialize() override;
 
 private:
+	void RegisterAuditRoutes();
+
 	TUniquePtr<FAssetRefHttpServer> HttpServer;
+	TWeakObjectPtr<class UBlueprintAuditSubsystem> AuditSubsystem;
 };
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class FBlueprintAuditBundle;
+class FBlueprintAuditCheckpoint;
+class FBlueprintAuditStream;
+class IAssetRegistry;
+
+/** One /Game/ Blueprint scheduled for a batch audit. */
+struct FBlueprintAuditWorkItem
+{
+	FAssetData Asset;
+	FString PackageName;
+	FString SourcePath;
+	FString OutputPath;
+
+	/** Current .uasset hash, when already computed by the incremental check. */
+	FString SourceFileHash;
+};
+
+/** Performance knobs shared by every commandlet mode that audits a list of Blueprints. */
+struct CORIDERUNREALENGINE_API FBlueprintAuditBatchOptions
+{
+	/** Worker threads for hashing, serialization and writes. 0 runs them inline. */
+	int32 NumThreads = 0;
+
+	/** Finished audits allowed to wait for a worker before the game thread blocks. */
+	int32 QueueDepth = 4;
+
+	/** Packages kept loading asynchronously ahead of the one being audited. 0 loads synchronously. */
+	int32 PrefetchDepth = 0;
+
+	/** Cap on the summed on-disk size of prefetched packages. */
+	int32 PrefetchBudgetMB = 512;
+
+	/** Used physical memory that triggers a GC (see FBlueprintAuditGCPolicy). 0 uses CoRider.Audit.GCBudgetMB. */
+	int32 GCBudgetMB = 0;
+
+	/** Minimum audited assets between GCs. 0 uses CoRider.Audit.GCMinInterval. */
+	int32 GCMinInterval = 0;
+
+	/** -Stream format; only "ndjson" is supported. Empty disables streaming. */
+	FString StreamFormat;
+
+	/** -StreamFile destination. Empty is FBlueprintAuditStream::GetDefaultPath(), "-" is stdout. */
+	FString StreamPath;
+
+	/** False with -NoTree: audits are only streamed, not written under Saved/Audit. */
+	bool bWriteTree = true;
+
+	/** Open sink for StreamFormat. Not parsed; the caller opens it (see FBlueprintAuditStream::Open). */
+	TSharedPtr<FBlueprintAuditStream> Stream;
+
+	/** -Bundle: also pack every audit into Saved/Audit/v<N>/Blueprints.bundle; -BundleCompress zlib-compresses its records. */
+	bool bWriteBundle = false;
+	bool bCompressBundle = false;
+
+	/** Open bundle for bWriteBundle. Not parsed; the caller opens and commits it (see FBlueprintAuditBundle::Open). */
+	TSharedPtr<FBlueprintAuditBundle> Bundle;
+
+	/** Read the options above from commandlet params. */
+	static FBlueprintAuditBatchOptions FromParams(const FString& Params);
+
+	/** Format the options back into commandlet params, e.g. to forward them to a child process. */
+	FString ToParams() const;
+};
+
+/** Outcome of FBlueprintAuditBatch::Run. */
+struct FBlueprintAuditBatchResult
+{
+	int32 WrittenCount = 0;
+	int32 ExtractedCount = 0;
+
+	/** Of WrittenCount, audits identical to the file on disk, which was left untouched. */
+	int32 UnchangedCount = 0;
+
+	/** Packages that failed to load or whose audit could not be written, sorted. */
+	TArray<FString> FailedPackages;
+
+	double LoadSeconds = 0.0;
+	double ExtractSeconds = 0.0;
+	double ElapsedSeconds = 0.0;
+
+	int32 GCCount = 0;
+	double GCSeconds = 0.0;
+};
+
+/**
+ * Game-thread audit loop shared by the commandlet's all-assets mode and its worker processes:
+ * optional async prefetch, UObject walk on the game thread, hashing/serialization/writes through
+ * FBlueprintAuditPipeline, and memory-driven garbage collection.
+ */
+struct CORIDERUNREALENGINE_API FBlueprintAuditBatch
+{
+	/** Called on the game thread once each item is extracted and queued for writing (true) or fails to load (false). Its write may still be in flight; use a checkpoint to track what landed. */
+	using FOnItemAudited = TFunction<void(const FBlueprintAuditWorkItem& Item, bool bAudited)>;
+
+	/**
+	 * All /Game/ Blueprints known to the registry, sorted by package name so every process sees the
+	 * same order. OutSkipCount receives the number of non-project Blueprints filtered out.
+	 */
+	static TArray<FAssetData> GetProjectBlueprints(IAssetRegistry& AssetRegistry, int32& OutSkipCount);
+
+	/** Read an asset list from a file, or from stdin when Source is "-". One entry per line. */
+	static bool ReadAssetList(const FString& Source, TArray<FString>& OutEntries);
+
+	/**
+	 * Resolve asset-list entries through the registry. An entry is a package name (/Game/UI/WBP_Foo),
+	 * an object path, or a .uasset file path (absolute, or relative to the project directory).
+	 * Blank lines and lines starting with # are ignored, as are non-/Game/ packages.
+	 * @param OutItems            Listed Blueprints, in list order.
+	 * @param OutMissingPackages  Listed /Game/ packages that no longer hold a Blueprint: deleted, renamed, or replaced by another asset type.
+	 * @param bRescanFiles        Rescan each listed file first, for long-lived processes whose registry may be out of date.
+	 */
+	static void ResolveAssetList(const TArray<FString>& Entries, TArray<FBlueprintAuditWorkItem>& OutItems,
+		TArray<FString>& OutMissingPackages, bool bRescanFiles = false);
+
+	/** Resolve source and output paths for a Blueprint asset. */
+	static FBlueprintAuditWorkItem MakeWorkItem(const FAssetData& Asset);
+
+	/**
+	 * Check every item in parallel (see FBlueprintAuditor::IsAuditUpToDate) and drop the up-to-date ones.
+	 * Nothing is loaded. Survivors keep any hash computed on the way so the pipeline doesn't hash them again.
+	 * Shared by -Incremental and the editor's startup stale check.
+	 * Returns the number of up-to-date items removed.
+	 */
+	static int32 RemoveUpToDateItems(TArray<FBlueprintAuditWorkItem>& WorkItems);
+
+	/**
+	 * Audit every item in order and wait for all writes to finish. Logs per-stage timings.
+	 * @param Checkpoint  Optional journal to record progress in, so an interrupted run can be resumed.
+	 */
+	static FBlueprintAuditBatchResult Run(const TArray<FBlueprintAuditWorkItem>& WorkItems,
+		const FBlueprintAuditBatchOptions& Options, const FOnItemAudited& OnItemAudited = nullptr,
+		FBlueprintAuditCheckpoint* Checkpoint = nullptr);
+
+	/**
+	 * Pack items' audit files from the tree into the bundle: those it has no record of, or every one with
+	 * bReimport (e.g. after -Workers, whose children write only the tree). Unchanged files aren't appended again.
+	 * Items without an audit file (failed ones) are skipped. Returns the number of files read. Doesn't commit.
+	 */
+	static int32 PackTreeIntoBundle(FBlueprintAuditBundle& Bundle, const TArray<FBlueprintAuditWorkItem>& Items, bool bReimport);
+};
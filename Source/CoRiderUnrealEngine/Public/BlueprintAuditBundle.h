@@ -0,0 +1,143 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FBlueprintAuditFileLock;
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/** One record in a packed audit bundle. */
+struct FBlueprintAuditBundleEntry
+{
+	FString PackageName;
+
+	/** Byte range of the stored record within the bundle. */
+	uint64 Offset = 0;
+	uint32 StoredSize = 0;
+
+	/** Size and xxh64 of the audit JSON before compression. */
+	uint32 RawSize = 0;
+	uint64 Hash = 0;
+
+	/** 0 = stored as is, 1 = zlib. */
+	uint8 Compression = 0;
+};
+
+/**
+ * Packed audit bundle (-Bundle): every Blueprint's compact audit JSON in one file,
+ * Saved/Audit/v<N>/Blueprints.bundle, written alongside the per-file tree.
+ *
+ * Layout, little-endian:
+ *   Header   "CRAB", format version, AuditSchemaVersion, entry count, index offset, index size (32 bytes)
+ *   Records  audit JSON bodies, each optionally zlib-compressed, in write order
+ *   Index    fixed 40-byte entries sorted by UTF-8 package name (name offset/length, record offset,
+ *            stored/raw size, xxh64 of the raw JSON, compression), followed by the names they point into
+ *
+ * Readers map the file and binary-search the index (see FBlueprintAuditBundleReader). Writers append
+ * changed records and a fresh index, then rewrite the header, so an on-save update costs a few KB
+ * instead of a full rewrite. Superseded records and old indexes are dead space until Commit compacts
+ * the bundle through a temp file.
+ *
+ * One writer at a time: Open takes an advisory lock on Blueprints.bundle.lock (FBlueprintAuditFileLock)
+ * and fails while another process holds it, on every platform.
+ *
+ * On Windows a writer's open handle denies write sharing, so a reader's OpenMapped fails while a writer
+ * has the bundle open; the editor only keeps it open between a put and the commit that follows. Likewise,
+ * compaction can't replace a bundle some reader still has mapped: the move fails, the temp copy is dropped,
+ * and the index is committed in place, leaving compaction to a later commit.
+ */
+class CORIDERUNREALENGINE_API FBlueprintAuditBundle
+{
+public:
+	/** <ProjectDir>/Saved/Audit/v<N>/Blueprints.bundle */
+	static FString GetDefaultPath();
+
+	/**
+	 * Open a bundle for update, loading its index. A missing bundle, or one from another schema version,
+	 * is started over. Returns null if another writer holds the lock or the file can't be opened for writing.
+	 */
+	static TSharedPtr<FBlueprintAuditBundle> Open(const FString& Path, bool bCompress);
+
+	/** Closes the file without committing; uncommitted records are dead space the next writer drops. */
+	~FBlueprintAuditBundle();
+
+	FBlueprintAuditBundle(const FBlueprintAuditBundle&) = delete;
+	FBlueprintAuditBundle& operator=(const FBlueprintAuditBundle&) = delete;
+
+	/** Store a package's audit JSON. Identical content is not appended again. Thread-safe. Returns false on a write error. */
+	bool Put(const FString& PackageName, TConstArrayView<uint8> Json);
+
+	/** Put the contents of an audit file from the tree. */
+	bool PutFile(const FString& PackageName, const FString& JsonPath);
+
+	bool Contains(const FString& PackageName) const;
+	void Remove(const FString& PackageName);
+
+	/** Drop every record whose package isn't in LivePackages. Returns the number dropped. */
+	int32 RemoveAllExcept(const TSet<FString>& LivePackages);
+
+	/** Write the index and header, compacting first when dead space outweighs live records. Thread-safe. */
+	bool Commit();
+
+	int32 Num() const;
+
+	/** Records appended, and puts skipped because the content was unchanged, since Open. */
+	int32 GetAppendedCount() const { return AppendedCount; }
+	int32 GetUnchangedCount() const { return UnchangedCount; }
+
+private:
+	FBlueprintAuditBundle(const FString& InPath, bool bInCompress);
+
+	/** Write the sorted index at EndOffset and point the header at it. Caller holds Lock. */
+	bool WriteIndexAndHeader(IFileHandle& Handle, int64& InOutEndOffset, const TArray<const FBlueprintAuditBundleEntry*>& Sorted);
+
+	/** Rewrite live records into a fresh file and move it over the bundle. Caller holds Lock. */
+	bool Compact(const TArray<const FBlueprintAuditBundleEntry*>& Sorted);
+
+	FString Path;
+	bool bCompress = false;
+
+	mutable FCriticalSection Lock;
+	TUniquePtr<FBlueprintAuditFileLock> WriterLock;
+	TUniquePtr<IFileHandle> FileHandle;
+	TMap<FString, FBlueprintAuditBundleEntry> Entries;
+	int64 EndOffset = 0;
+	int64 LiveBytes = 0;
+	bool bDirty = false;
+
+	int32 AppendedCount = 0;
+	int32 UnchangedCount = 0;
+};
+
+/** Read-only view of a bundle through a memory mapping. Lookups binary-search the mapped index in place. */
+class CORIDERUNREALENGINE_API FBlueprintAuditBundleReader
+{
+public:
+	/** Map a bundle. Returns null if it is missing, malformed, or from another schema version. */
+	static TUniquePtr<FBlueprintAuditBundleReader> Open(const FString& Path);
+	~FBlueprintAuditBundleReader();
+
+	int32 Num() const { return EntryCount; }
+
+	/** Entry at Index in package-name order. */
+	FBlueprintAuditBundleEntry GetEntry(int32 Index) const;
+
+	bool Find(const FString& PackageName, FBlueprintAuditBundleEntry& OutEntry) const;
+
+	/** Copy out (and decompress) a record's audit JSON. */
+	bool ReadRecord(const FBlueprintAuditBundleEntry& Entry, TArray<uint8>& OutJson) const;
+
+private:
+	FBlueprintAuditBundleReader() = default;
+
+	/** Name bytes of the entry at Index, pointing into the mapping. */
+	TConstArrayView<uint8> GetEntryName(int32 Index) const;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+	int32 EntryCount = 0;
+	uint64 IndexOffset = 0;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintAuditBatch.h"
+
+/**
+ * Append-only journal that lets an interrupted batch audit pick up where it stopped (-Resume).
+ *
+ * Saved/Audit/v<N>/Checkpoints/<Name>.journal starts with a fingerprint of the work list, followed by
+ * one line per state change: "begin" before a Blueprint is loaded, "extracted" once its audit is queued,
+ * and "done"/"failed" once its write has landed. Writes are committed in batches after a pipeline flush,
+ * so "done" never gets ahead of the file on disk. A package left at "begin" was being loaded or walked
+ * when the process died; a resumed run quarantines it instead of loading it again.
+ */
+class CORIDERUNREALENGINE_API FBlueprintAuditCheckpoint
+{
+public:
+	/**
+	 * @param Name       Journal name, one per kind of run (e.g. "all", "shard-0-of-4") so concurrent shards don't collide.
+	 * @param WorkItems  The full work list; a journal recorded for a different list is never resumed.
+	 * @param Directory  Where to keep the journal. Defaults to Saved/Audit/v<N>/Checkpoints.
+	 */
+	FBlueprintAuditCheckpoint(const FString& Name, const TArray<FBlueprintAuditWorkItem>& WorkItems, const FString& Directory = FString());
+	~FBlueprintAuditCheckpoint();
+
+	FBlueprintAuditCheckpoint(const FBlueprintAuditCheckpoint&) = delete;
+	FBlueprintAuditCheckpoint& operator=(const FBlueprintAuditCheckpoint&) = delete;
+
+	/**
+	 * Start journaling. With bResume, a journal for the same work list is kept and appended to;
+	 * otherwise (or when the fingerprint differs) it starts empty. Returns true when resuming.
+	 */
+	bool Open(bool bResume);
+
+	/** Drop items the resumed run finished or quarantined. Returns the number of finished items dropped. */
+	int32 RemoveResolvedItems(TArray<FBlueprintAuditWorkItem>& WorkItems) const;
+
+	/** Packages that crashed a previous run, sorted. */
+	const TArray<FString>& GetQuarantined() const { return Quarantined; }
+
+	void MarkStarted(const FString& PackageName);
+	void MarkFailed(const FString& PackageName);
+
+	/** The audit is queued for writing; it becomes "done" on the next CommitExtracted. */
+	void MarkExtracted(const FString& PackageName);
+
+	/** Record every extracted package as done, or failed if listed in FailedPackages. Call once their writes have landed. */
+	void CommitExtracted(const TArray<FString>& FailedPackages);
+
+	/** Record an outcome decided in another process (a -Workers child, or the parent's crash quarantine). */
+	void MarkDone(const FString& PackageName);
+	void MarkQuarantined(const FString& PackageName);
+
+	/** Close and delete the journal. Call once the run reached the end of its work list. */
+	void Finish();
+
+	/**
+	 * Last recorded state of every package in a journal: "begin", "extracted", "done", "failed" or "quarantined".
+	 * Lets another process (the -Workers parent) see how far a dead writer got.
+	 */
+	static TMap<FString, FString> ReadStates(const FString& JournalPath);
+
+private:
+	void Append(const TCHAR* State, const FString& PackageName);
+
+	FString JournalPath;
+	FString Fingerprint;
+	TUniquePtr<FArchive> Writer;
+
+	TSet<FString> Completed;
+	TArray<FString> Quarantined;
+	TArray<FString> Extracted;
+};
@@ -9,9 +9,37 @@
  *
  * Usage:
  *   UnrealEditor-Cmd.exe Project.uproject -run=BlueprintAudit [-AssetPath=/Game/Path/To/BP] [-Output=path.json]
+ *                        [-Threads=N] [-QueueDepth=N] [-Incremental] [-Prefetch=N] [-PrefetchBudgetMB=N]
+ *                        [-GCBudgetMB=N] [-GCMinInterval=N]
+ *                        [-Shard=i/N] [-Workers=N] [-BatchSize=N] [-AssetList=<file>|-] [-Resume]
+ *                        [-Stream=ndjson] [-StreamFile=path] [-NoTree]
+ *   UnrealEditor-Cmd.exe Project.uproject -run=BlueprintAudit -MergeShards[=N]
+ *   UnrealEditor-Cmd.exe Project.uproject -run=BlueprintAudit -Daemon [-IdleTimeout=Seconds]
  *
  * If -AssetPath is omitted, all Blueprints in the project are audited
  * and each gets its own JSON file under Saved/Audit/Blueprints/.
+ * -Threads=N hands source hashing, JSON serialization and file writes to N worker
+ * threads while the game thread keeps loading and walking Blueprints. At most
+ * -QueueDepth finished audits (default 4 per thread) wait in memory at once.
+ * -Incremental hashes each .uasset first and only loads Blueprints whose stored
+ * SourceFileHash differs, then sweeps audit files whose asset no longer exists.
+ * -Prefetch=N keeps N packages loading asynchronously ahead of the one being
+ * audited, capped at -PrefetchBudgetMB (default 512) of on-disk package size.
+ * -GCBudgetMB / -GCMinInterval override the FBlueprintAuditGCPolicy console variables.
+ * -Shard=i/N audits only the Blueprints hashed into slice i and records them in a
+ * shard manifest; -MergeShards checks the manifests cover every project Blueprint.
+ * -Workers=N runs the audit in N child commandlets (see FBlueprintAuditWorkers);
+ * children are launched internally with -WorkerQueue=<dir> -WorkerId=<k>.
+ * -AssetList=<file> audits only the listed package names or .uasset paths ("-" reads
+ * stdin) and deletes audit files for listed assets that no longer exist.
+ * Batch runs journal their progress (see FBlueprintAuditCheckpoint); -Resume skips what an
+ * interrupted run with the same work list finished and quarantines the asset it crashed on.
+ * -Stream=ndjson emits each audit as one compact JSON line to -StreamFile (default
+ * Saved/Audit/v<N>/Stream.ndjson; "-" is stdout) once it is written; -NoTree skips the
+ * per-file tree so the stream is the only output.
+ *
+ * -Daemon keeps the process warm and takes audit jobs over HTTP (see FBlueprintAuditDaemon)
+ * until it has been idle for -IdleTimeout seconds (default 600).
  *
  * If -AssetPath is provided, a single JSON file is written to -Output
  * (defaults to <ProjectDir>/BlueprintAudit.json).
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintAuditBatch.h"
+
+class FAssetRefHttpServer;
+class FJsonObject;
+
+/**
+ * Resident audit process (-Daemon).
+ *
+ * Boots the editor and scans the asset registry once, then takes audit jobs over local HTTP so callers
+ * don't pay for editor startup on every refresh. Serves through FAssetRefHttpServer (same port range,
+ * asset-ref routes included) and advertises itself in Saved/.corider-ue-audit-daemon.json.
+ *
+ *   GET  /audit/health
+ *   POST /audit/jobs      {"packages": ["/Game/UI/WBP_Foo", "Content/UI/WBP_Bar.uasset"]} or {"stale": true}
+ *   GET  /audit/status    ?job=<id> for one job, otherwise all recent jobs
+ *   POST /audit/shutdown
+ *
+ * Jobs run one at a time on the game thread, in submission order, and HTTP keeps being served while one
+ * runs so callers can poll progress. Shutdown finishes the running job and cancels the queued ones.
+ * The process exits after IdleTimeoutSeconds with no request and no job.
+ */
+class CORIDERUNREALENGINE_API FBlueprintAuditDaemon
+{
+public:
+	FBlueprintAuditDaemon(const FBlueprintAuditBatchOptions& InOptions, double InIdleTimeoutSeconds);
+	~FBlueprintAuditDaemon();
+
+	FBlueprintAuditDaemon(const FBlueprintAuditDaemon&) = delete;
+	FBlueprintAuditDaemon& operator=(const FBlueprintAuditDaemon&) = delete;
+
+	/** Serve until shut down or idle. Returns the commandlet exit code. */
+	int32 Run();
+
+private:
+	struct FJob
+	{
+		int32 Id = 0;
+
+		/** Asset-list entries; empty for a stale job. */
+		TArray<FString> Entries;
+		bool bStale = false;
+
+		/** queued, running, done, or cancelled (dropped by /audit/shutdown before it started). */
+		FString State = TEXT("queued");
+		int32 Total = 0;
+		int32 Processed = 0;
+		int32 Written = 0;
+		int32 Unchanged = 0;
+		int32 UpToDate = 0;
+		int32 Removed = 0;
+		TArray<FString> FailedPackages;
+
+		double SubmitTime = 0.0;
+		double StartTime = 0.0;
+		double FinishTime = 0.0;
+	};
+
+	void RegisterRoutes();
+
+	/** Run one job to completion, serving HTTP in between items. */
+	void RunJob(FJob& Job);
+
+	/**
+	 * Refresh the registry for .uasset files under Content/ that changed since the last scan, or that it
+	 * doesn't know. Returns the Blueprint packages whose file is gone.
+	 */
+	TArray<FString> RescanChangedFiles();
+
+	/**
+	 * Tick the core ticker, which drives the HTTP listeners. Rate-limited unless bForce. While a job runs
+	 * no time elapses for the ticker, so only per-frame tickers such as the listeners run.
+	 */
+	void PumpHttp(bool bForce);
+
+	static TSharedPtr<FJsonObject> JobToJson(const FJob& Job);
+
+	FBlueprintAuditBatchOptions Options;
+	double IdleTimeoutSeconds = 0.0;
+
+	TUniquePtr<FAssetRefHttpServer> HttpServer;
+
+	/** Shared so a job stays valid while HTTP handlers add to the containers mid-run. */
+	TArray<TSharedRef<FJob>> Jobs;
+	TArray<TSharedRef<FJob>> PendingJobs;
+	int32 NextJobId = 1;
+
+	double StartedTime = 0.0;
+	double LastActivityTime = 0.0;
+	double LastPumpTime = 0.0;
+	double LastTickTime = 0.0;
+	FDateTime LastScanTime;
+	bool bJobRunning = false;
+	bool bShutdownRequested = false;
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Typed audit of one Blueprint, filled directly by FBlueprintAuditor and written out by a serializer
+ * (see FBlueprintAuditor::SerializeAuditJson). Plain values only — no UObject references — so a finished
+ * audit can be moved to a worker thread and outlive the Blueprint it describes.
+ *
+ * Field names mirror the JSON schema; bump FBlueprintAuditor::AuditSchemaVersion when either changes.
+ */
+
+struct FBlueprintAuditVariable
+{
+	FName Name;
+	FString Type;
+	FString Category;
+	bool bInstanceEditable = false;
+	bool bReplicated = false;
+};
+
+struct FBlueprintAuditPropertyOverride
+{
+	FName Name;
+
+	/** ExportText of the CDO value. */
+	FString Value;
+};
+
+struct FBlueprintAuditComponent
+{
+	FName Name;
+	FName Class;
+};
+
+struct FBlueprintAuditTimeline
+{
+	FName Name;
+	float Length = 0.0f;
+	bool bLooping = false;
+	bool bAutoPlay = false;
+	int32 FloatTrackCount = 0;
+	int32 VectorTrackCount = 0;
+	int32 LinearColorTrackCount = 0;
+	int32 EventTrackCount = 0;
+};
+
+struct FBlueprintAuditWidget
+{
+	FName Name;
+	FName Class;
+	bool bIsVariable = false;
+
+	/** Panels get a Children array, even when empty; other widgets don't. */
+	bool bIsPanel = false;
+	TArray<FBlueprintAuditWidget> Children;
+};
+
+/** A literal value on an unlinked function call input pin. */
+struct FBlueprintAuditPinDefault
+{
+	FName Name;
+	FString Value;
+};
+
+struct FBlueprintAuditFunctionCall
+{
+	FName Function;
+
+	/** Owning class of the called function, or "Self" when it can't be resolved. */
+	FName Target;
+	bool bIsNative = false;
+	TArray<FBlueprintAuditPinDefault> DefaultInputs;
+};
+
+struct FBlueprintAuditGraph
+{
+	FName Name;
+	int32 TotalNodes = 0;
+
+	/** Node titles, e.g. "Event BeginPlay" or "CustomEvent: OnDied". */
+	TArray<FString> Events;
+	TArray<FBlueprintAuditFunctionCall> FunctionCalls;
+
+	/** Unique and sorted, so re-auditing an unchanged graph produces identical output. */
+	TArray<FName> VariablesRead;
+	TArray<FName> VariablesWritten;
+
+	TArray<FName> MacroInstances;
+};
+
+struct FBlueprintAuditMacroGraph
+{
+	FName Name;
+	int32 NodeCount = 0;
+};
+
+struct FBlueprintAuditData
+{
+	FString Name;
+	FString Path;
+	FString ParentClass;
+	FString BlueprintType;
+
+	/**
+	 * Hash of the .uasset. Empty with a non-empty algorithm is a placeholder for a hash filled in later;
+	 * both are empty (and omitted from the output) when the package has no file on disk.
+	 */
+	FString SourceFileHash;
+	FString SourceFileHashAlgorithm;
+
+	/** Asset registry saved hash; omitted from the output when empty. */
+	FString PackageSavedHash;
+
+	TArray<FBlueprintAuditVariable> Variables;
+	TArray<FBlueprintAuditPropertyOverride> PropertyOverrides;
+	TArray<FName> Interfaces;
+	TArray<FBlueprintAuditComponent> Components;
+	TArray<FBlueprintAuditTimeline> Timelines;
+
+	/** Widget Blueprints only. */
+	TOptional<FBlueprintAuditWidget> WidgetTree;
+
+	TArray<FBlueprintAuditGraph> EventGraphs;
+	TArray<FBlueprintAuditGraph> FunctionGraphs;
+	TArray<FBlueprintAuditMacroGraph> MacroGraphs;
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Exclusive advisory lock on a file, shared by every editor and commandlet process on the machine.
+ *
+ * Held until destroyed: flock() on Linux/macOS, a handle opened without sharing on Windows. The OS drops
+ * it when the holder dies, so a crash never leaves the lock stuck. Guards files that several processes
+ * update in place (the audit bundle, the source hash manifest); the lock file itself stays empty.
+ */
+class CORIDERUNREALENGINE_API FBlueprintAuditFileLock
+{
+public:
+	/** Lock LockPath (created if missing), retrying for up to TimeoutSeconds. Check IsLocked(). */
+	explicit FBlueprintAuditFileLock(const FString& LockPath, double TimeoutSeconds = 0.0);
+	~FBlueprintAuditFileLock();
+
+	FBlueprintAuditFileLock(const FBlueprintAuditFileLock&) = delete;
+	FBlueprintAuditFileLock& operator=(const FBlueprintAuditFileLock&) = delete;
+
+	bool IsLocked() const { return bLocked; }
+
+private:
+	bool TryLock();
+
+	FString LockPath;
+	bool bLocked = false;
+#if PLATFORM_WINDOWS
+	void* Handle = nullptr;
+#else
+	int32 Descriptor = -1;
+#endif
+};
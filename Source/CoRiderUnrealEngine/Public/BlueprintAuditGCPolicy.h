@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Decides when a batch audit collects garbage.
+ *
+ * Instead of a fixed asset count, it collects when used physical memory crosses a budget, but never
+ * more often than every MinAssetsBetween assets. Small Blueprints then rarely pay for a GC, and a run
+ * of huge widget Blueprints can't push the machine into swap before the next one.
+ *
+ * Defaults come from console variables, so the editor can be tuned from DefaultEngine.ini [SystemSettings]:
+ *   CoRider.Audit.GCBudgetMB        Used physical memory that triggers a GC. 0 = half of physical RAM.
+ *   CoRider.Audit.GCMinInterval     Minimum assets between collections (default 8).
+ */
+class CORIDERUNREALENGINE_API FBlueprintAuditGCPolicy
+{
+public:
+	/** Values <= 0 fall back to the console variables. */
+	explicit FBlueprintAuditGCPolicy(int32 BudgetMB = 0, int32 MinAssetsBetween = 0);
+
+	/** Call once per audited asset. Returns true if it collected garbage. */
+	bool Tick();
+
+	/** Count an audited asset without collecting; the editor then collects from CollectIfDue while the user is idle. */
+	void AddAsset() { ++AssetsSinceCollect; }
+
+	/** Collect garbage if enough assets were audited since the last collection and memory is over budget. */
+	bool CollectIfDue();
+
+	int32 GetCollectCount() const { return CollectCount; }
+	double GetCollectSeconds() const { return CollectSeconds; }
+
+	/** Log collection count, time and peak used memory against the budget. */
+	void LogSummary() const;
+
+	/** Budget in MB that a policy built with BudgetMB would use. */
+	static int32 ResolveBudgetMB(int32 BudgetMB);
+
+private:
+	uint64 BudgetBytes = 0;
+	int32 MinAssetsBetween = 1;
+	int32 AssetsSinceCollect = 0;
+
+	int32 CollectCount = 0;
+	double CollectSeconds = 0.0;
+	uint64 PeakUsedPhysical = 0;
+	bool bWarnedOverBudget = false;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Persistent .uasset hash manifest: Saved/Audit/v<N>/SourceHashes.tsv.
+ *
+ * One line per package with its file size, modification time, hash algorithm and content hash. A file whose
+ * size, timestamp and algorithm still match reuses the cached hash, so a warm stale check reads no .uasset
+ * content at all.
+ * Shared by the editor subsystem and the commandlet; Save() merges with whatever another process wrote
+ * in the meantime and replaces the file with a rename, holding SourceHashes.tsv.lock while it does.
+ * The editor batches saves: it requests one and writes it once the user is idle or a background burst ends.
+ *
+ * Thread-safe: batch audits hash from worker threads.
+ */
+class CORIDERUNREALENGINE_API FBlueprintAuditHashCache
+{
+public:
+	/** Process-wide instance, loaded from disk on first use. */
+	static FBlueprintAuditHashCache& Get();
+
+	/** Content hash of PackageName's .uasset at SourcePath, from the manifest when size and timestamp match. Empty on failure. */
+	FString GetFileHash(const FString& PackageName, const FString& SourcePath);
+
+	/** Forget a package, e.g. after it was deleted or renamed. */
+	void Remove(const FString& PackageName);
+
+	/**
+	 * Write the manifest if anything changed since the last load or save. Rewrites the whole file, so call it sparingly.
+	 * Waits up to LockTimeoutSeconds for another process's save; on timeout the cache stays dirty for a later call.
+	 * Returns false if the manifest could not be written.
+	 */
+	bool Save(double LockTimeoutSeconds = 5.0);
+
+private:
+	struct FEntry
+	{
+		int64 Size = 0;
+		int64 Timestamp = 0;
+		FString Algorithm;
+		FString Hash;
+	};
+
+	FBlueprintAuditHashCache();
+
+	static FString GetManifestPath();
+	static void LoadEntries(const FString& Path, TMap<FString, FEntry>& OutEntries);
+
+	FCriticalSection Lock;
+	TMap<FString, FEntry> Entries;
+	TSet<FString> Removed;
+	bool bDirty = false;
+
+	/** Bumped by every change, so a save can tell whether more arrived while it wrote the file. */
+	uint64 Generation = 0;
+
+	int32 Hits = 0;
+	int32 Misses = 0;
+};
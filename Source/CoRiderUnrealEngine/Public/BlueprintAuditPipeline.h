@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintAuditData.h"
+
+#include <atomic>
+
+class FBlueprintAuditBundle;
+class FBlueprintAuditStream;
+class FEvent;
+class FQueuedThreadPool;
+
+/**
+ * A finished Blueprint audit handed off by the game thread.
+ * Holds no UObject references, so it is safe to process after the Blueprint is garbage collected.
+ */
+struct FBlueprintAuditWriteJob
+{
+	FString PackageName;
+
+	/** .uasset on disk. Hashed by the pipeline to fill the SourceFileHash placeholder. */
+	FString SourcePath;
+
+	/** Already-known .uasset hash (e.g. from an incremental check). When set, the pipeline does not re-hash. */
+	FString SourceFileHash;
+
+	/** Destination audit JSON path. */
+	FString OutputPath;
+
+	/** Audit produced with bHashSourceFile=false. */
+	FBlueprintAuditData Audit;
+};
+
+/**
+ * Bounded write pipeline for batch audits.
+ *
+ * The game thread does the UObject walk (FBlueprintAuditor::AuditBlueprint) and enqueues the result;
+ * source hashing and the streamed JSON write run on a dedicated thread pool. Enqueue blocks
+ * while MaxInFlight jobs are pending so memory stays flat regardless of project size.
+ *
+ * With NumThreads <= 0 every stage runs inline on the calling thread (the original serial behavior).
+ */
+class CORIDERUNREALENGINE_API FBlueprintAuditPipeline
+{
+public:
+	/**
+	 * @param InStream       When set, every audit is also emitted as one NDJSON record once its tree file is written.
+	 * @param bInWriteFiles  False skips the per-file tree, leaving the stream as the only output.
+	 * @param InBundle       When set, every audit's compact JSON is also put in the bundle (committed by the caller).
+	 */
+	FBlueprintAuditPipeline(int32 NumThreads, int32 MaxInFlight,
+		TSharedPtr<FBlueprintAuditStream> InStream = nullptr, bool bInWriteFiles = true,
+		TSharedPtr<FBlueprintAuditBundle> InBundle = nullptr);
+	~FBlueprintAuditPipeline();
+
+	FBlueprintAuditPipeline(const FBlueprintAuditPipeline&) = delete;
+	FBlueprintAuditPipeline& operator=(const FBlueprintAuditPipeline&) = delete;
+
+	/** Queue a job. Blocks the caller while the queue is full (backpressure). */
+	void Enqueue(FBlueprintAuditWriteJob&& Job);
+
+	/** Block until every queued job has finished. */
+	void Flush();
+
+	/** Audits delivered: written to the tree, or streamed when the tree is off. */
+	int32 GetWrittenCount() const { return WrittenCount.load(); }
+	int32 GetFailedCount() const { return FailedCount.load(); }
+
+	/** Delivered audits whose file already held identical content, so the write was skipped. */
+	int32 GetUnchangedCount() const { return UnchangedCount.load(); }
+
+	/** Packages whose audit could not be written. Call after Flush(). */
+	TArray<FString> GetFailedPackages() const;
+
+	/** Log per-stage totals and throughput. Call after Flush(). */
+	void LogSummary() const;
+
+private:
+	/** Hash and write a single job. Runs on a pool thread (or inline). */
+	void ProcessJob(FBlueprintAuditWriteJob& Job);
+
+	FQueuedThreadPool* ThreadPool = nullptr;
+	FEvent* SlotFreedEvent = nullptr;
+	int32 NumThreads = 0;
+	int32 MaxInFlight = 1;
+
+	TSharedPtr<FBlueprintAuditStream> Stream;
+	bool bWriteFiles = true;
+	TSharedPtr<FBlueprintAuditBundle> Bundle;
+
+	std::atomic<int32> InFlight{0};
+	std::atomic<int32> WrittenCount{0};
+	std::atomic<int32> FailedCount{0};
+	std::atomic<int32> UnchangedCount{0};
+
+	mutable FCriticalSection FailedPackagesLock;
+	TArray<FString> FailedPackages;
+
+	// Per-stage totals, summed across worker threads
+	std::atomic<int32> HashedCount{0};
+	std::atomic<uint64> HashCycles{0};
+	std::atomic<uint64> SerializeCycles{0};
+	std::atomic<uint64> WriteCycles{0};
+	std::atomic<int64> SerializedBytes{0};
+	std::atomic<int64> WrittenBytes{0};
+
+	/** Time the producer spent blocked on a full queue. Only touched by the enqueuing thread. */
+	double StallSeconds = 0.0;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/StrongObjectPtr.h"
+
+class UPackage;
+
+/**
+ * Sliding window of LoadPackageAsync requests for the commandlet's batch mode.
+ *
+ * Packages are consumed strictly in order. While the game thread audits package I, packages
+ * I+1..I+Depth are already loading, so disk I/O and deserialization overlap with audit work.
+ * The window is bounded both by depth and by the summed on-disk size of packages that have been
+ * requested but not yet released. Until released, a loaded package and its top-level assets are held
+ * by strong references, so the batch loop's GC can't collect the Blueprint out from under it and force
+ * a synchronous reload.
+ */
+class CORIDERUNREALENGINE_API FBlueprintAuditPrefetcher
+{
+public:
+	/**
+	 * @param InPackageNames  Packages in consumption order.
+	 * @param InPackageSizes  On-disk size of each package (same order), charged against the budget.
+	 * @param InMaxDepth      Maximum number of outstanding packages, including the one being consumed.
+	 * @param InBudgetBytes   Maximum summed on-disk size of outstanding packages. At least one package is always allowed.
+	 */
+	FBlueprintAuditPrefetcher(TArray<FName> InPackageNames, TArray<int64> InPackageSizes, int32 InMaxDepth, int64 InBudgetBytes);
+	~FBlueprintAuditPrefetcher();
+
+	FBlueprintAuditPrefetcher(const FBlueprintAuditPrefetcher&) = delete;
+	FBlueprintAuditPrefetcher& operator=(const FBlueprintAuditPrefetcher&) = delete;
+
+	/** Block until package Index has finished loading. Returns it, or nullptr if the load failed. */
+	UPackage* Wait(int32 Index);
+
+	/** Stop keeping package Index alive and top the window back up. */
+	void Release(int32 Index);
+
+	/** Give queued loads a bounded slice of game-thread time between audits. */
+	void Pump(double TimeLimitSeconds);
+
+	/** Total time Wait() spent blocked on loads. */
+	double GetWaitSeconds() const { return WaitSeconds; }
+
+	/** Number of Wait() calls whose package was already resident. */
+	int32 GetReadyHits() const { return ReadyHits; }
+
+private:
+	struct FSlot
+	{
+		int32 RequestId = INDEX_NONE;
+		int64 Bytes = 0;
+		bool bDone = false;
+		TStrongObjectPtr<UPackage> Package;
+		/** The package alone doesn't keep its exports alive; the asset is what the caller resolves. */
+		TArray<TStrongObjectPtr<UObject>> Assets;
+	};
+
+	/** Issue requests until the window is full by depth or budget. */
+	void Refill();
+
+	/** Issue the LoadPackageAsync request for a single package. */
+	void Issue(int32 Index);
+
+	TArray<FName> PackageNames;
+	TArray<int64> PackageSizes;
+	TMap<int32, FSlot> Window;
+	int32 NextToIssue = 0;
+	int32 MaxDepth = 1;
+	int64 BudgetBytes = 0;
+	int64 WindowBytes = 0;
+	double WaitSeconds = 0.0;
+	int32 ReadyHits = 0;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Deterministic partition of the project's Blueprints for split commandlet runs (-Shard=i/N).
+ *
+ * A package belongs to shard (CRC32 of its lowercased name) mod N, so every process computes the
+ * same partition without coordination and shards stay balanced as assets are added. Each shard
+ * records what it covered in Saved/Audit/v<N>/Shards/shard-<i>-of-<N>.json; -MergeShards combines
+ * those manifests into a completeness report. Per-file audit JSON layout is unaffected.
+ */
+struct CORIDERUNREALENGINE_API FBlueprintAuditShard
+{
+	int32 Index = 0;
+	int32 Count = 1;
+
+	/** Parse "i/N" (0 <= i < N). Returns false on malformed input. */
+	static bool Parse(const FString& Spec, FBlueprintAuditShard& OutShard);
+
+	/** Whether the given package belongs to this shard. */
+	bool Contains(const FString& PackageName) const;
+
+	/** Directory holding shard manifests and the merge report: <ProjectDir>/Saved/Audit/v<N>/Shards */
+	static FString GetManifestDir();
+
+	/** Manifest path for this shard. */
+	FString GetManifestPath() const;
+
+	/** Delete this shard's manifest so a run that dies early can't leave a stale one behind. */
+	void DeleteManifest() const;
+
+	/**
+	 * Write this shard's manifest.
+	 * @param AssignedPackages  Every package this shard owned, including ones skipped as up-to-date.
+	 * @param FailedPackages    Owned packages that could not be loaded or written.
+	 */
+	bool WriteManifest(const TArray<FString>& AssignedPackages, const TArray<FString>& FailedPackages,
+		int32 WrittenCount, int32 UpToDateCount, double ElapsedSeconds) const;
+
+	/**
+	 * Combine all manifests for a shard count and compare against the expected package list.
+	 * Writes merge-report.json next to the manifests. ShardCount <= 0 infers it from the manifests on disk.
+	 * Returns a commandlet exit code: 0 if every expected package was covered by a shard and none failed.
+	 */
+	static int32 MergeManifests(const TArray<FString>& ExpectedPackages, int32 ShardCount);
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Sink for -Stream=ndjson: one compact audit record per line, written as soon as its audit is on disk.
+ *
+ * Writes to a file (a named pipe works too), Saved/Audit/v<N>/Stream.ndjson by default, or to stdout.
+ * Every record is flushed immediately so a consumer can index results while the run is still going.
+ * Thread-safe: pipeline workers write to it concurrently, so records arrive in completion order, not
+ * package order.
+ *
+ * On stdout, where log lines are interleaved, each record starts with RecordSeparator (an RFC 7464
+ * JSON text sequence), so a record can't be mistaken for a log line or vice versa.
+ */
+class CORIDERUNREALENGINE_API FBlueprintAuditStream
+{
+public:
+	/** Leads each record written to stdout. */
+	static constexpr ANSICHAR RecordSeparator = '\x1e';
+
+	/**
+	 * Open a sink. Empty is GetDefaultPath(), "-" is stdout. Returns null if the file can't be created.
+	 * With bKeyed, each record starts with its package name and a tab: the format -Workers children
+	 * hand to their parent, which strips the key before forwarding.
+	 */
+	static TSharedPtr<FBlueprintAuditStream> Open(const FString& Path, bool bKeyed = false);
+
+	/** Saved/Audit/v<N>/Stream.ndjson, truncated by each run. */
+	static FString GetDefaultPath();
+
+	/** Append PackageName's record. Json is one line of UTF-8 without its newline, which is added here. */
+	void WriteRecord(const FString& PackageName, const ANSICHAR* Json, int64 Length);
+
+private:
+	FBlueprintAuditStream() = default;
+
+	FCriticalSection Lock;
+	bool bKeyed = false;
+
+	/** Null when writing to stdout. */
+	TUniquePtr<FArchive> FileWriter;
+};
@@ -1,18 +1,54 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "BlueprintAuditBatch.h"
+#include "BlueprintAuditGCPolicy.h"
+#include "BlueprintAuditor.h"
 #include "Containers/Ticker.h"
 #include "EditorSubsystem.h"
+#include "UObject/StrongObjectPtr.h"
 #include "BlueprintAuditSubsystem.generated.h"
 
+class FBlueprintAuditBundle;
+class IAssetEditorInstance;
+class SNotificationItem;
+class UAssetEditorSubsystem;
+struct FFileChangeData;
+
+/** Background re-audit priority classes, highest first. */
+enum class EBlueprintAuditPriority : uint8
+{
+	/** Asked for over HTTP (e.g. by the Rider plugin answering a query about it). */
+	Requested,
+	/** Open in an asset editor tab. */
+	OpenInEditor,
+	/** Changed on disk recently (VCS sync, another tool). */
+	RecentlySaved,
+	/** Found stale by the startup check. */
+	Background,
+};
+
 /**
  * Editor subsystem that automatically audits Blueprint assets on save.
  * Hooks into UPackage::PackageSavedWithContextEvent and writes a per-file
  * JSON audit to Saved/Audit/Blueprints/, mirroring the Content directory layout.
  *
- * On startup, runs a deferred stale-check: compares each Blueprint's .uasset
- * MD5 hash against the stored SourceFileHash in its audit JSON. Any stale or
- * missing entries are re-audited automatically.
+ * On startup, runs a deferred stale-check: compares each Blueprint's stored hashes
+ * against the asset registry (or the .uasset itself) off the game thread, then
+ * re-audits stale or missing entries in the background. Background audits are
+ * time-sliced on the core ticker (CoRider.Audit.BackgroundBudgetMs per tick), pause
+ * while the user is interacting, and report progress in an editor notification.
+ *
+ * While running, watches the project's Content directory so .uasset changes made
+ * outside the editor (e.g. a VCS sync) are re-audited the same way. Bursts of changes
+ * are coalesced, and only the changed Blueprints are checked.
+ *
+ * Queued re-audits run by priority (see EBlueprintAuditPriority), so a Blueprint that is
+ * open or was just asked about never waits behind the rest of the project.
+ *
+ * Re-audits on save are incremental: graphs and widget trees unchanged since the previous
+ * save of the same Blueprint this session are reused rather than walked again.
  */
 UCLASS()
 class CORIDERUNREALENGINE_API UBlueprintAuditSubsystem : public UEditorSubsystem
@@ -24,23 +60,175 @@ public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 
+	/**
+	 * Check a Blueprint now and, if its audit is stale or missing, queue it at Priority, or raise it
+	 * to Priority if it is already queued. Returns false if its audit is already up to date.
+	 */
+	bool RequestAudit(const FBlueprintAuditWorkItem& Item, EBlueprintAuditPriority Priority = EBlueprintAuditPriority::Requested);
+
 private:
+	struct FPendingAudit
+	{
+		FBlueprintAuditWorkItem Item;
+		EBlueprintAuditPriority Priority = EBlueprintAuditPriority::Background;
+		uint64 Sequence = 0;
+
+		/** Heap order: higher priority first, then first come first served. */
+		bool operator<(const FPendingAudit& Other) const
+		{
+			return Priority != Other.Priority ? Priority < Other.Priority : Sequence < Other.Sequence;
+		}
+	};
+
+	/** A queued Blueprint popped for audit, while its package loads. */
+	struct FBackgroundLoad
+	{
+		FBlueprintAuditWorkItem Item;
+		EBlueprintAuditPriority Priority = EBlueprintAuditPriority::Background;
+		int32 RequestId = INDEX_NONE;
+		bool bDone = false;
+		TStrongObjectPtr<UPackage> Package;
+		/** The package's top-level assets; holding the package alone doesn't keep its exports from a GC. */
+		TArray<TStrongObjectPtr<UObject>> Assets;
+	};
+
+	/** Outcome of an up-to-date check's off-thread phase. */
+	struct FStaleCheckResult
+	{
+		const TCHAR* Label = TEXT("");
+		EBlueprintAuditPriority Priority = EBlueprintAuditPriority::Background;
+		TArray<FBlueprintAuditWorkItem> StaleItems;
+		int32 ScannedCount = 0;
+		int32 UpToDateCount = 0;
+		double Seconds = 0.0;
+	};
+
 	void OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
 
+	/** Section cache for a Blueprint being re-audited on save; evicts the least recently saved beyond the limit. */
+	FBlueprintAuditor::FSectionCache& FindOrAddSectionCache(const FString& BlueprintPath);
+
+	/**
+	 * The audit bundle, opened on first use while CoRider.Audit.Bundle is on. Null when it is off, or another
+	 * process (e.g. a -Bundle commandlet run) has the bundle open. The first open of a session seeds it from
+	 * the audit tree, so it doesn't stay limited to the Blueprints saved or re-audited since it was enabled.
+	 */
+	FBlueprintAuditBundle* GetBundle();
+	void PutInBundle(const FString& PackageName, const FBlueprintAuditData& Audit);
+	void RemoveFromBundle(const FString& PackageName);
+
+	/** Commit pending bundle changes and close it, so the editor only holds the bundle while it has something to write. */
+	void CommitBundle();
+
 	/** Delete the audit JSON when a Blueprint asset is removed from the project. */
 	void OnAssetRemoved(const FAssetData& AssetData);
 
 	/** Delete the old-path audit JSON when a Blueprint asset is renamed or moved. */
 	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
 
-	/** Ticker callback: waits for asset registry, then runs the stale check once. */
-	bool OnStaleCheckTick(float DeltaTime);
+	/** Ticker callback: starts the stale check once the asset registry is ready, then drains background audits within the frame budget. */
+	bool OnBackgroundTick(float DeltaTime);
+
+	/** DirectoryWatcher callback: remember changed .uasset files until the burst settles. */
+	void OnContentDirectoryChanged(const TArray<FFileChangeData>& FileChanges);
+
+	/** Gather all project Blueprints and check them, then clean up orphans and old schema directories. */
+	void StartStaleCheck();
+
+	/** Launch the parallel up-to-date check on the thread pool; stale items are queued when it finishes. */
+	void StartUpToDateCheck(TArray<FBlueprintAuditWorkItem>&& Items, const TCHAR* Label, EBlueprintAuditPriority Priority, bool bCleanUpAuditTree);
+
+	/** Rescan changed files in the registry until the deadline, then check the Blueprints among them. */
+	void ResolveChangedFiles(double Deadline);
+
+	/** Queue a Blueprint for a background re-audit, or raise its priority if it is already queued. Ignored while it is loading. */
+	void EnqueueAudit(FBlueprintAuditWorkItem&& Item, EBlueprintAuditPriority Priority);
+
+	/** Bump a queued Blueprint when it is opened in an asset editor. */
+	void OnAssetOpenedInEditor(UObject* Asset, IAssetEditorInstance* EditorInstance);
+
+	/** Package names of every asset currently open in an asset editor. */
+	TSet<FString> GetOpenPackageNames() const;
+
+	/**
+	 * Audit queued Blueprints until the deadline, keeping a few package loads in flight.
+	 * With bRequestedOnly, only EBlueprintAuditPriority::Requested items are started or finished.
+	 */
+	void ProcessPendingAudits(double Deadline, bool bRequestedOnly = false);
+
+	/** Pop the next queued Blueprint and start loading its package, unless it is already in memory. */
+	void StartNextLoad();
+
+	/** Loads[Index] finished (or failed): audit it, write its JSON and release the package. */
+	void FinishLoadedAudit(int32 Index);
+
+	FBackgroundLoad* FindLoad(const FString& PackageName);
+
+	/** Pin Load.Package's assets so an idle-time GC can't free a Blueprint waiting to be audited. */
+	static void HoldAssets(FBackgroundLoad& Load);
+
+	/** False when a loaded package has unsaved edits or was loaded from an older version of its file. */
+	static bool IsResidentPackageCurrent(const UPackage* Package);
+
+	/** True while the user has interacted with the editor within CoRider.Audit.BackgroundIdleSeconds. */
+	static bool IsUserInteracting();
+
+	void UpdateProgressNotification();
+	void FinishBackgroundBurst();
+
+	/** Record that PackageName's audit was just written, for a stale check that is still running. */
+	void NoteAudited(const FString& PackageName);
+
+	/** Save the source hash manifest a little later, once the user is idle, instead of after every event. */
+	void RequestHashCacheSave();
+
+	/** Save the source hash manifest now without blocking; if another process holds it, request a later save. */
+	void SaveHashCache();
+
+	FTSTicker::FDelegateHandle BackgroundTickerHandle;
+
+	/** When a requested hash manifest save is due; 0 when none is pending. */
+	double HashCacheSaveTime = 0.0;
+
+	/** Stale check: not started until the registry finishes loading. One up-to-date check runs on the thread pool at a time. */
+	bool bStaleCheckStarted = false;
+	bool bRescanRequested = false;
+	TFuture<FStaleCheckResult> CheckFuture;
+
+	/** Packages audited while CheckFuture runs; its stale list predates those audits, so they are not queued again. */
+	TSet<FString> AuditedDuringCheck;
+
+	/** Content directory watch: files changed since the last quiet period, then the ones being resolved. */
+	FString WatchedContentDir;
+	FDelegateHandle DirectoryWatcherHandle;
+	TSet<FString> ChangedFiles;
+	double LastFileChangeTime = 0.0;
+	TArray<FString> FilesToResolve;
+	TArray<FBlueprintAuditWorkItem> ChangedItems;
+
+	/** Blueprints waiting for a background re-audit: a heap ordered by FPendingAudit::operator<, plus its package names. */
+	TArray<FPendingAudit> PendingAudits;
+	TSet<FString> PendingPackages;
+	uint64 NextPendingSequence = 0;
+
+	TWeakObjectPtr<UAssetEditorSubsystem> AssetEditorSubsystem;
+
+	/** Section caches of the Blueprints saved most recently, oldest first in SectionCacheOrder. */
+	TMap<FString, FBlueprintAuditor::FSectionCache> SectionCaches;
+	TArray<FString> SectionCacheOrder;
 
-	/** Iterate all project Blueprints and re-audit any whose .uasset hash differs from the stored JSON hash. */
-	void AuditStaleBlueprints();
+	TSharedPtr<FBlueprintAuditBundle> Bundle;
+	bool bBundleSeeded = false;
 
-	/** Walk the audit directory and delete JSON files whose source .uasset no longer exists. */
-	void SweepOrphanedAuditFiles();
+	/** Blueprints whose packages are loading asynchronously (up to CoRider.Audit.BackgroundLoads), oldest first. */
+	TArray<FBackgroundLoad> Loads;
 
-	FTSTicker::FDelegateHandle StaleCheckTickerHandle;
+	/** Progress of the current burst of background audits; reset once the queue drains. */
+	int32 BurstTotal = 0;
+	int32 BurstAudited = 0;
+	int32 BurstFailed = 0;
+	int32 BurstSkipped = 0;
+	double BurstStartTime = 0.0;
+	TOptional<FBlueprintAuditGCPolicy> BurstGCPolicy;
+	TSharedPtr<SNotificationItem> ProgressNotification;
 };
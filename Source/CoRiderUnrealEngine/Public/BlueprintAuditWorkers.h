@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintAuditBatch.h"
+
+/**
+ * Multi-process batch audit (-Workers=N).
+ *
+ * UObject loading is single-threaded, so past a point the only way to use more cores is more editor
+ * processes. The parent commandlet splits its work list into small batch files under
+ * Saved/Audit/v<N>/Workers/<RunId>/pending/ and launches N child commandlets with -WorkerQueue=<dir>.
+ * Each child claims one batch at a time by atomically renaming it into claimed/, so a child that
+ * finishes early simply claims more (rebalancing happens on its own), and journals each package
+ * (FBlueprintAuditCheckpoint) under progress/: "begin" before loading it, "done" or "failed" only once
+ * its write has landed. Counts go to results/ after every batch. When a child dies, the parent re-queues
+ * whatever its claimed batches had not finished and relaunches it; a package left at "begin" during two
+ * crashes is quarantined as failed instead of being retried again. Only crashes count against a slot's
+ * relaunch budget.
+ */
+struct CORIDERUNREALENGINE_API FBlueprintAuditWorkers
+{
+	/**
+	 * Parent side: audit WorkItems across NumWorkers child processes and log one merged summary
+	 * with wall-clock time and per-worker throughput.
+	 * As each batch finishes (or a dead child's journal is recovered), its outcomes are recorded in
+	 * Checkpoint and its audits packed into Options.Bundle, so a killed parent still leaves -Resume something.
+	 * @param BatchSize   Packages per batch file. <= 0 picks a size that gives each worker several batches.
+	 * @param Checkpoint  Optional journal for the whole run.
+	 */
+	static FBlueprintAuditBatchResult RunOrchestrator(const TArray<FBlueprintAuditWorkItem>& WorkItems,
+		int32 NumWorkers, int32 BatchSize, const FBlueprintAuditBatchOptions& Options,
+		FBlueprintAuditCheckpoint* Checkpoint = nullptr);
+
+	/** Child side: claim and audit batches from QueueDir until none are left. Returns the commandlet exit code. */
+	static int32 RunWorker(const FString& QueueDir, int32 WorkerId, const FBlueprintAuditBatchOptions& Options);
+};
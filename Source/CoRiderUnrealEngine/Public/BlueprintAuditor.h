@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "BlueprintAuditData.h"
 #include "Dom/JsonObject.h"
 
 class UBlueprint;
@@ -15,21 +16,51 @@ DECLARE_LOG_CATEGORY_EXTERN(LogCoRider, Log, All);
  */
 struct CORIDERUNREALENGINE_API FBlueprintAuditor
 {
-	/** Bump when the JSON schema changes to invalidate all cached audit files. */
-	static constexpr int32 AuditSchemaVersion = 2;
+	/**
+	 * Bump when the audit schema (see FBlueprintAuditData) changes to invalidate all cached audit files.
+	 * Covers both encodings: JSON and Compact Binary files live side by side under the same v<N> directory.
+	 */
+	static constexpr int32 AuditSchemaVersion = 3;
 
-	/** Produce a JSON object summarizing the given Blueprint. */
-	static TSharedPtr<FJsonObject> AuditBlueprint(const UBlueprint* BP);
+	/**
+	 * Per-section fingerprints and audits from a previous audit of one Blueprint, for incremental re-audits.
+	 * Fingerprints hash names by index, so a cache is only valid within the editor session that filled it.
+	 */
+	struct FSectionCache
+	{
+		/** Keyed by section, e.g. "WidgetTree" or "FunctionGraphs/MyFunction". */
+		TMap<FString, uint64> Fingerprints;
+		TMap<FString, FBlueprintAuditGraph> Graphs;
+		TOptional<FBlueprintAuditWidget> WidgetTree;
 
-	/** Produce a JSON object summarizing a single graph. */
-	static TSharedPtr<FJsonObject> AuditGraph(const UEdGraph* Graph);
+		/** Sections reused and recomputed by the last audit that used this cache. */
+		int32 ReusedCount = 0;
+		int32 RecomputedCount = 0;
+	};
 
-	/** Produce a JSON object summarizing a single widget and its children. */
-	static TSharedPtr<FJsonObject> AuditWidget(class UWidget* Widget);
+	/**
+	 * Audit the given Blueprint.
+	 * KnownSourceFileHash, when set, is a hash the caller already computed (e.g. by a stale check) and is used as is.
+	 * Otherwise, when bHashSourceFile is false, SourceFileHash is left as an empty placeholder
+	 * so the caller can fill it in later (e.g. on a worker thread).
+	 * With a SectionCache, event/function graphs and the widget tree whose fingerprint is unchanged since the
+	 * cached audit are reused instead of walked again; the cache is updated to this audit.
+	 */
+	static FBlueprintAuditData AuditBlueprint(const UBlueprint* BP, bool bHashSourceFile = true, const FString& KnownSourceFileHash = FString(),
+		FSectionCache* SectionCache = nullptr);
+
+	/** Audit a single graph. */
+	static FBlueprintAuditGraph AuditGraph(const UEdGraph* Graph);
+
+	/** Audit a single widget and its children. */
+	static FBlueprintAuditWidget AuditWidget(class UWidget* Widget);
 
 	/** Human-readable type string for a Blueprint variable pin type. */
 	static FString GetVariableTypeString(const FEdGraphPinType& PinType);
 
+	/** Return the versioned audit root: <ProjectDir>/Saved/Audit/v<N> */
+	static FString GetAuditVersionDir();
+
 	/** Return the base directory for all audit JSON files: <ProjectDir>/Saved/Audit/v<N>/Blueprints */
 	static FString GetAuditBaseDir();
 
@@ -40,7 +71,7 @@ struct CORIDERUNREALENGINE_API FBlueprintAuditor
 	static FString GetAuditOutputPath(const UBlueprint* BP);
 	static FString GetAuditOutputPath(const FString& PackageName);
 
-	/** Delete an audit JSON file. Returns true if the file was deleted or did not exist. */
+	/** Delete an audit JSON file and its Compact Binary sibling. Returns true if the JSON was deleted or did not exist. */
 	static bool DeleteAuditJson(const FString& JsonPath);
 
 	/**
@@ -48,9 +79,97 @@ struct CORIDERUNREALENGINE_API FBlueprintAuditor
 	 */
 	static FString GetSourceFilePath(const FString& PackageName);
 
-	/** Compute an MD5 hash of the file at the given path. Returns empty string on failure. */
+	/**
+	 * Algorithm behind SourceFileHash, from CoRider.Audit.HashAlgorithm: "md5" (default) or "xxh64".
+	 * Recorded in each audit as SourceFileHashAlgorithm.
+	 */
+	static FString GetSourceHashAlgorithm();
+
+	/** Hash the file at the given path with GetSourceHashAlgorithm(). Returns empty string on failure. */
 	static FString ComputeFileHash(const FString& FilePath);
 
+	/**
+	 * Identity of a package as last saved: the asset registry's FAssetPackageData saved hash.
+	 * Returns empty string when the registry has no data for it. Safe to call from any thread.
+	 */
+	static FString GetPackageSavedHash(const FString& PackageName);
+
+	/**
+	 * Hashes recorded in an existing audit JSON. Fields are empty when missing or unreadable.
+	 * Reads only the metadata at the head of the file; the audit body is never parsed.
+	 */
+	struct FStoredHashes
+	{
+		FString SourceFileHash;
+		FString SourceFileHashAlgorithm;
+		FString PackageSavedHash;
+	};
+	static FStoredHashes ReadStoredHashes(const FString& JsonPath);
+
+	/**
+	 * Whether the audit JSON at JsonPath still matches the package. Compares the registry's package saved hash
+	 * when both sides have one (memory lookups only), and falls back to the .uasset content hash otherwise.
+	 * A missing Compact Binary sibling makes the audit stale while IsCompactBinaryEnabled().
+	 * OutSourceFileHash receives the content hash when the fallback computed one. Safe to call from any thread.
+	 */
+	static bool IsAuditUpToDate(const FString& PackageName, const FString& SourcePath, const FString& JsonPath, FString* OutSourceFileHash = nullptr);
+
+	/**
+	 * Delete audit files (JSON and Compact Binary) that don't match a live /Game/ Blueprint, and temp files left by interrupted writes. Diffs the audit tree against one registry
+	 * query, so it is safe (and meant) to run off the game thread. Files written after that query are left for the
+	 * next sweep, so a Blueprint created mid-sweep keeps its fresh audit. Returns the number deleted.
+	 */
+	static int32 SweepOrphanedAuditFiles(int64* OutBytesReclaimed = nullptr);
+
+	/** Delete Saved/Audit/v<N> directories left by older schema versions. Returns the number deleted. */
+	static int32 DeleteOldAuditVersions(int64* OutBytesReclaimed = nullptr);
+
+	/** Whether audit files are written indented (CoRider.Audit.PrettyJson, or -Pretty on the commandlet). */
+	static bool IsPrettyJson();
+
+	/** Stream an audit into an archive as UTF-8 JSON, compact unless bPretty. Safe to call from any thread. */
+	static void SerializeAuditJson(const FBlueprintAuditData& Audit, FArchive& Ar, bool bPretty = false);
+
+	/** Whether every audit also gets a Compact Binary sibling (CoRider.Audit.CompactBinary, or -CompactBinary on the commandlet). */
+	static bool IsCompactBinaryEnabled();
+
+	/** Write an audit into an archive as one Compact Binary object (FCbWriter), with the same fields in the same order as the JSON. Safe to call from any thread. */
+	static void SerializeAuditCompactBinary(const FBlueprintAuditData& Audit, FArchive& Ar);
+
+	/** Compact Binary sibling of an audit JSON path: <...>/WBP_Foo.json -> <...>/WBP_Foo.ucb */
+	static FString GetCompactBinaryPath(const FString& JsonPath);
+
+	/** Content type of a Compact Binary audit over HTTP. */
+	static constexpr const TCHAR* CompactBinaryContentType = TEXT("application/x-ue-cb");
+
+	/** Serialize a JSON object (manifests, reports) into a string; bCondensed gives a single line. Safe to call from any thread. */
+	static FString SerializeAuditJson(const TSharedPtr<FJsonObject>& JsonObject, bool bCondensed = false);
+
+	/** Write already-serialized audit JSON to disk. Safe to call from any thread. Returns true on success. */
+	static bool SaveAuditString(const FString& JsonString, const FString& OutputPath);
+
+	/** Ends the name of a file being written (<path>.<pid>-<thread>.tmp); the finished file is moved into place. */
+	static constexpr const TCHAR* TempFileSuffix = TEXT(".tmp");
+
+	/** A temp path beside Path that no other process or thread writing Path at the same time will pick. */
+	static FString MakeTempFilePath(const FString& Path);
+
+	/**
+	 * Move SourcePath over DestPath in one step, so a reader sees either the old file or the new one, never
+	 * neither: MoveFileExW(MOVEFILE_REPLACE_EXISTING) on Windows, rename() elsewhere. IFileManager::Move
+	 * deletes the destination first instead.
+	 */
+	static bool ReplaceFile(const FString& DestPath, const FString& SourcePath);
+
+	/**
+	 * Write an audit to disk as UTF-8 JSON, honoring IsPrettyJson(), plus its Compact Binary sibling when
+	 * IsCompactBinaryEnabled(). Safe to call from any thread. Returns true on success.
+	 * A file that already holds the same bytes is left untouched (bOutUnchanged when all of them are, and
+	 * they don't count towards OutBytesWritten); others are replaced through a temp file, so readers never
+	 * see a partial audit.
+	 */
+	static bool WriteAuditJson(const FBlueprintAuditData& Audit, const FString& OutputPath, int64* OutBytesWritten = nullptr, bool* bOutUnchanged = nullptr);
+
 	/** Serialize a JSON object and write it to disk. Returns true on success. */
 	static bool WriteAuditJson(const TSharedPtr<FJsonObject>& JsonObject, const FString& OutputPath);
 };